@@ -0,0 +1,18 @@
+#include "bench_address.hpp"
+#include "bench_helper.hpp"
+
+// ADRS overhead per F call, while walking a WOTS+ chain, with whole ADRS serialized on each step ( = 0 ), with only
+// hash address rewritten on each step ( = 1 ) and without calling F ( = 2 )
+
+BENCHMARK(bench_sphincs_plus_address::chain_step<16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128-simple/adrs_chain_step")
+  ->DenseRange(0, 2)
+  ->ArgName("mode")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_address::chain_step<32, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256-simple/adrs_chain_step")
+  ->DenseRange(0, 2)
+  ->ArgName("mode")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
@@ -0,0 +1,93 @@
+#pragma once
+#include "hashing.hpp"
+#include "prng.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark overhead of SPHINCS+ ADRS handling, on F calls
+namespace bench_sphincs_plus_address {
+
+// Benchmark walking a WOTS+ chain of w - 1 steps, reporting cost per F call, while
+//
+// - ( mode = 0 ) setting hash address and serializing whole ADRS into input of F, on each step
+// - ( mode = 1 ) serializing input prefix of F once and rewriting only hash address, on each step
+// - ( mode = 2 ) only setting hash address and serializing whole ADRS, without calling F, isolating ADRS overhead
+template<size_t n, sphincs_plus_hashing::variant v>
+static inline void
+chain_step(benchmark::State& state)
+{
+  constexpr uint32_t steps = 15u;
+  const int64_t mode = state.range(0);
+
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> chained{};
+  std::array<uint8_t, n> tmp{};
+  std::array<uint8_t, n + sphincs_plus_adrs::ADRS_BYTE_WIDTH> prefix{};
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> adrs_bytes{};
+
+  auto _prefix = std::span(prefix);
+  auto _adrs = _prefix.template subspan<n, sphincs_plus_adrs::ADRS_BYTE_WIDTH>();
+
+  prng::prng_t prng;
+  prng.read(pk_seed);
+  prng.read(chained);
+  prng.read(adrs_bytes);
+
+  sphincs_plus_adrs::wots_hash_t adrs{ sphincs_plus_adrs::adrs_t(adrs_bytes) };
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    if (mode == 0) {
+      for (uint32_t i = 0; i < steps; i++) {
+        adrs.set_hash_address(i);
+
+        sphincs_plus_hashing::f<n, v>(pk_seed, adrs, chained, tmp);
+        std::copy(tmp.begin(), tmp.end(), chained.begin());
+      }
+    } else if (mode == 1) {
+      adrs.set_hash_address(0u);
+
+      std::copy(pk_seed.begin(), pk_seed.end(), _prefix.template subspan<0, n>().begin());
+      adrs.to_bytes(_adrs);
+
+      for (uint32_t i = 0; i < steps; i++) {
+        sphincs_plus_hashing::t_l_prefixed<n, 1, v>(_prefix, chained, tmp);
+        std::copy(tmp.begin(), tmp.end(), chained.begin());
+
+        adrs.inc_hash_address();
+        adrs.template word_to_bytes<7>(_adrs);
+      }
+    } else {
+      for (uint32_t i = 0; i < steps; i++) {
+        adrs.set_hash_address(i);
+        adrs.to_bytes(_adrs);
+
+        benchmark::DoNotOptimize(_adrs);
+      }
+    }
+
+    benchmark::DoNotOptimize(chained);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(steps) * state.iterations());
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc/F"] = static_cast<double>(total_ticks) / static_cast<double>(steps);
+#endif
+}
+
+}
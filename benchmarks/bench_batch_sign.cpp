@@ -0,0 +1,37 @@
+#include "bench_batch_sign.hpp"
+#include "bench_helper.hpp"
+
+// Batch sizes vary from 1 to 64K messages, each message being 64 -bytes
+
+BENCHMARK(bench_sphincs_plus_batch::sign<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128s-simple/batch_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_batch::verify<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128s-simple/batch_verify")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_sphincs_plus_batch::sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128f-simple/batch_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_batch::verify<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128f-simple/batch_verify")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_sphincs_plus_batch::sign<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256f-simple/batch_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_batch::verify<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256f-simple/batch_verify")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 16, 16), { 64 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
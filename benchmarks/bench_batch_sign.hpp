@@ -0,0 +1,181 @@
+#pragma once
+#include "batch_sign.hpp"
+#include "prng.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+#include <cassert>
+
+// Benchmark SPHINCS+ Batch Signing Routines
+namespace bench_sphincs_plus_batch {
+
+// Benchmark signing a batch of `state.range(0)` -many messages, each of `state.range(1)` -bytes, using a single
+// SPHINCS+ signature. Throughput is reported in terms of messages signed per second.
+template<const size_t n,
+         const uint32_t h,
+         const uint32_t d,
+         const uint32_t a,
+         const uint32_t k,
+         const size_t w,
+         const sphincs_plus_hashing::variant v>
+static inline void
+sign(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t msg_cnt = static_cast<size_t>(state.range(0));
+  const size_t mlen = static_cast<size_t>(state.range(1));
+  const size_t proof_len = sphincs_plus_batch::get_proof_len<n>(msg_cnt);
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(msg_cnt * mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+  std::vector<uint8_t> proofs(msg_cnt * proof_len, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+  auto _proofs = std::span(proofs);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+
+  std::vector<std::span<const uint8_t>> batch;
+  for (size_t i = 0; i < msg_cnt; i++) {
+    batch.push_back(_msgs.subspan(i * mlen, mlen));
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_batch::sign<n, h, d, a, k, w, v>(batch, _skey, {}, _sig, _proofs);
+
+    benchmark::DoNotOptimize(_msgs);
+    benchmark::DoNotOptimize(_skey);
+    benchmark::DoNotOptimize(_sig);
+    benchmark::DoNotOptimize(_proofs);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(msg_cnt));
+  state.counters["proof_len"] = static_cast<double>(proof_len);
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations()) * static_cast<uint64_t>(msg_cnt);
+  state.counters["rdtsc/msg"] = static_cast<double>(total_ticks);
+#endif
+}
+
+// Benchmark verifying all messages of a batch of `state.range(0)` -many messages, each of `state.range(1)` -bytes,
+// using a fresh batch verifier, so that SPHINCS+ signature is verified once per batch. Throughput is reported in terms
+// of messages verified per second.
+template<const size_t n,
+         const uint32_t h,
+         const uint32_t d,
+         const uint32_t a,
+         const uint32_t k,
+         const size_t w,
+         const sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t msg_cnt = static_cast<size_t>(state.range(0));
+  const size_t mlen = static_cast<size_t>(state.range(1));
+  const size_t proof_len = sphincs_plus_batch::get_proof_len<n>(msg_cnt);
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(msg_cnt * mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+  std::vector<uint8_t> proofs(msg_cnt * proof_len, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+  auto _proofs = std::span(proofs);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+
+  std::vector<std::span<const uint8_t>> batch;
+  for (size_t i = 0; i < msg_cnt; i++) {
+    batch.push_back(_msgs.subspan(i * mlen, mlen));
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus_batch::sign<n, h, d, a, k, w, v>(batch, _skey, {}, _sig, _proofs);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  bool flag = true;
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_batch::verifier_t<n, h, d, a, k, w, v> verifier(_pkey);
+    for (size_t i = 0; i < msg_cnt; i++) {
+      flag &= verifier.verify(batch[i], _sig, _proofs.subspan(i * proof_len, proof_len));
+    }
+
+    benchmark::DoNotOptimize(flag);
+    benchmark::DoNotOptimize(_msgs);
+    benchmark::DoNotOptimize(_sig);
+    benchmark::DoNotOptimize(_proofs);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  assert(flag);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(msg_cnt));
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations()) * static_cast<uint64_t>(msg_cnt);
+  state.counters["rdtsc/msg"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
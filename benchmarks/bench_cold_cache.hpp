@@ -0,0 +1,250 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined __linux__
+#include <unistd.h>
+#endif
+
+// Benchmark SPHINCS+ signing and verification, with caches ( and optionally TLB ) thrashed before each call, so that
+// latency on a request path, where other work has evicted working set of the library, can be compared against latency
+// in a tight loop.
+namespace bench_sphincs_plus_cold_cache {
+
+// Whether caches and TLB are left warm, by previous iteration, or thrashed before each iteration.
+enum class mode_t : int
+{
+  warm = 0,
+  cold = 1,     // Data caches, all the way up to last-level cache, are thrashed
+  cold_tlb = 2, // Data caches and TLB are thrashed
+};
+
+// Size of a cache line and a page, in bytes, assumed while thrashing
+constexpr size_t CACHE_LINE = 64;
+constexpr size_t PAGE = 4096;
+
+// # -of pages touched for thrashing TLB ( = 64 MB ), far more than any second-level TLB has entries for
+constexpr size_t TLB_PAGE_CNT = 1ul << 14;
+
+// Returns size of last-level cache, in bytes, falling back to 32 MB, when it can't be queried.
+static inline size_t
+llc_bytes()
+{
+#if defined __linux__ && defined _SC_LEVEL3_CACHE_SIZE
+  const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (l3 > 0) {
+    return static_cast<size_t>(l3);
+  }
+
+  const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (l2 > 0) {
+    return static_cast<size_t>(l2);
+  }
+#endif
+
+  return 32ul << 20;
+}
+
+// Evicts working set of the library, by writing to each cache line of a buffer, twice as large as last-level cache, so
+// that dirty lines are also written back. In `cold_tlb` mode, it also touches one cache line on each of many distinct
+// pages, so that address translations of the library get evicted from TLB.
+struct thrasher_t
+{
+private:
+  std::vector<uint8_t> cache_buf;
+  std::vector<uint8_t> tlb_buf;
+  size_t tlb_off = 0;
+
+public:
+  inline thrasher_t()
+    : cache_buf(std::max<size_t>(2 * llc_bytes(), 8ul << 20), 0)
+    , tlb_buf(TLB_PAGE_CNT * PAGE, 0)
+  {
+  }
+
+  inline void thrash(const mode_t mode)
+  {
+    if (mode == mode_t::warm) {
+      return;
+    }
+
+    for (size_t i = 0; i < cache_buf.size(); i += CACHE_LINE) {
+      cache_buf[i]++;
+    }
+
+    if (mode == mode_t::cold_tlb) {
+      // Cache line touched on each page keeps moving, so that TLB thrashing doesn't keep hitting same cache sets
+      tlb_off = (tlb_off + CACHE_LINE) % PAGE;
+      for (size_t i = tlb_off; i < tlb_buf.size(); i += PAGE) {
+        tlb_buf[i]++;
+      }
+    }
+
+    benchmark::DoNotOptimize(cache_buf.data());
+    benchmark::DoNotOptimize(tlb_buf.data());
+    benchmark::ClobberMemory();
+  }
+};
+
+// Returns thrasher, shared by all benchmarks of a translation unit, allocated on first use.
+static inline thrasher_t&
+get_thrasher()
+{
+  static thrasher_t thrasher;
+  return thrasher;
+}
+
+// Repeatedly calls `fn`, thrashing caches and TLB before each call, as per `mode`, and reporting time spent only in
+// `fn`, using manual timing. When warm run of same benchmark was run earlier, in same process, `vs_warm` reports
+// slowdown relative to it, which `baseline` ( in seconds per call ) remembers.
+template<typename fn_t>
+static inline void
+measure(benchmark::State& state, const mode_t mode, std::atomic<double>& baseline, fn_t&& fn)
+{
+  thrasher_t& thrasher = get_thrasher();
+
+  double total = 0.;
+  for (auto _ : state) {
+    thrasher.thrash(mode);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    fn();
+    benchmark::ClobberMemory();
+
+    const auto end = std::chrono::steady_clock::now();
+    const double secs = std::chrono::duration<double>(end - start).count();
+
+    state.SetIterationTime(secs);
+    total += secs;
+  }
+
+  const double avg = total / static_cast<double>(state.iterations());
+  if (mode == mode_t::warm) {
+    baseline.store(avg);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  const double warm = baseline.load();
+  if (warm > 0.) {
+    state.counters["vs_warm"] = avg / warm;
+  }
+}
+
+// Benchmark SPHINCS+ signing of an mlen -bytes message, with caches left warm or thrashed, as per `mode`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+sign(benchmark::State& state, const mode_t mode)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  // Shared by warm and cold runs
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+
+  measure(state, mode, baseline, [&]() {
+    sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+    benchmark::DoNotOptimize(_sig);
+  });
+}
+
+// Benchmark SPHINCS+ verification of a signature over an mlen -bytes message, with caches left warm or thrashed, as
+// per `mode`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state, const mode_t mode)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  // Shared by warm and cold runs
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+
+  bool flag = true;
+  measure(state, mode, baseline, [&]() {
+    flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig, pkey);
+    benchmark::DoNotOptimize(flag);
+  });
+
+  assert(flag);
+}
+
+// Registers warm and cold cache benchmarks of signing and verification, for given SPHINCS+ parameter set, under name
+// prefix `name`, say `sphincs+-128f-simple/sign_cold_tlb`. Warm ones are registered first, so that, when benchmarks
+// aren't interleaved, cold ones can report slowdown relative to them.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+register_all(const std::string& name)
+{
+  const auto add = [&](const std::string& routine, auto fn, const mode_t mode) {
+    return benchmark::RegisterBenchmark((name + "/" + routine).c_str(), fn, mode)
+      ->Arg(32)
+      ->ArgName("mlen")
+      ->UseManualTime()
+      ->ComputeStatistics("min", compute_min)
+      ->ComputeStatistics("max", compute_max);
+  };
+
+  add("sign_warm", sign<n, h, d, a, k, w, v>, mode_t::warm);
+  add("sign_cold", sign<n, h, d, a, k, w, v>, mode_t::cold);
+  add("sign_cold_tlb", sign<n, h, d, a, k, w, v>, mode_t::cold_tlb);
+  add("verify_warm", verify<n, h, d, a, k, w, v>, mode_t::warm);
+  add("verify_cold", verify<n, h, d, a, k, w, v>, mode_t::cold);
+  add("verify_cold_tlb", verify<n, h, d, a, k, w, v>, mode_t::cold_tlb);
+
+  return true;
+}
+
+}
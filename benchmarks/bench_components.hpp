@@ -0,0 +1,475 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "fors.hpp"
+#include "hypertree.hpp"
+#include "prng.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <string>
+
+// Benchmark building blocks of SPHINCS+ i.e. tweakable hash functions, WOTS+, XMSS, FORS and HyperTree, one at a time,
+// so that it's visible which of them an optimization moves time in.
+namespace bench_sphincs_plus_components {
+
+// Repeatedly calls `fn`, reporting average # -of CPU ticks spent per call ( on x86_64 ), while `fn` is expected to
+// invoke a tweakable hash function or PRF `hashes` -many times, per call, which is reported as items processed. Hash
+// counters are reported too, when enabled.
+template<typename fn_t>
+static inline void
+measure(benchmark::State& state, const int64_t hashes, fn_t&& fn)
+{
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  sphincs_plus_counters::reset();
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    fn();
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetItemsProcessed(hashes * state.iterations());
+  report_hash_counters(state);
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+// Fills each of given byte spans with pseudo-random bytes.
+template<typename... spans_t>
+static inline void
+randomize(prng::prng_t& prng, spans_t&&... spans)
+{
+  (prng.read(spans), ...);
+}
+
+// Returns a pseudo-random 32 -bytes address.
+static inline sphincs_plus_adrs::adrs_t
+random_adrs(prng::prng_t& prng)
+{
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> bytes{};
+  prng.read(bytes);
+
+  return sphincs_plus_adrs::adrs_t(bytes);
+}
+
+// Returns a pseudo-random 64 -bit unsigned integer.
+static inline uint64_t
+prng_u64(prng::prng_t& prng)
+{
+  std::array<uint8_t, sizeof(uint64_t)> bytes{};
+  prng.read(bytes);
+
+  uint64_t v = 0ul;
+  std::memcpy(&v, bytes.data(), bytes.size());
+
+  return v;
+}
+
+// Benchmark tweakable hash function T_l, on n * l -bytes message. F and H are T_l for l = 1 and l = 2, respectively,
+// while l = len is used for compressing WOTS+ public key.
+template<size_t n, size_t l, sphincs_plus_hashing::variant v>
+static inline void
+t_l(benchmark::State& state)
+{
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n * l> msg{};
+  std::array<uint8_t, n> dig{};
+
+  prng::prng_t prng;
+  randomize(prng, pk_seed, msg);
+  const auto adrs = random_adrs(prng);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_hashing::t_l<n, l, v>(pk_seed, adrs, msg, dig);
+    benchmark::DoNotOptimize(dig);
+  });
+
+  state.SetBytesProcessed(static_cast<int64_t>(n * l) * state.iterations());
+}
+
+// Benchmark pseudorandom function PRF, used for generating WOTS+ and FORS secret key elements.
+template<size_t n>
+static inline void
+prf(benchmark::State& state)
+{
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> dig{};
+
+  prng::prng_t prng;
+  randomize(prng, pk_seed, sk_seed);
+  const auto adrs = random_adrs(prng);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, adrs, dig);
+    benchmark::DoNotOptimize(dig);
+  });
+}
+
+// Benchmark keyed hash function H_msg, compressing a message of `state.range(0)` -bytes, into m -bytes digest, from
+// which FORS message and HyperTree indices are extracted.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k>
+static inline void
+h_msg(benchmark::State& state)
+{
+  constexpr size_t md_len = static_cast<size_t>((k * a + 7) / 8);
+  constexpr size_t itree_len = static_cast<size_t>((h - (h / d) + 7) / 8);
+  constexpr size_t ileaf_len = static_cast<size_t>(((h / d) + 7) / 8);
+  constexpr size_t m = md_len + itree_len + ileaf_len;
+
+  const size_t mlen = static_cast<size_t>(state.range(0));
+
+  std::array<uint8_t, n> r{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> pk_root{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::array<uint8_t, m> dig{};
+
+  auto _msg = std::span(msg);
+
+  prng::prng_t prng;
+  randomize(prng, r, pk_seed, pk_root, _msg);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_hashing::h_msg<n, m>(r, pk_seed, pk_root, _msg, dig);
+    benchmark::DoNotOptimize(dig);
+  });
+
+  state.SetBytesProcessed(static_cast<int64_t>(mlen) * state.iterations());
+}
+
+// Benchmark walking a WOTS+ chain, from its start to its end i.e. w - 1 invocations of F.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+wots_chain(benchmark::State& state)
+{
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> x{};
+  std::array<uint8_t, n> chained{};
+
+  prng::prng_t prng;
+  randomize(prng, pk_seed, x);
+  const sphincs_plus_adrs::wots_hash_t adrs{ random_adrs(prng) };
+
+  measure(state, static_cast<int64_t>(w - 1), [&]() {
+    sphincs_plus_wots::chain<n, w, v>(x, 0u, static_cast<uint32_t>(w - 1), adrs, pk_seed, chained);
+    benchmark::DoNotOptimize(chained);
+  });
+}
+
+// Benchmark WOTS+ public key generation i.e. len PRF calls, len * (w - 1) F calls and a single T_len call.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+wots_pkgen(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> pkey{};
+
+  prng::prng_t prng;
+  randomize(prng, sk_seed, pk_seed);
+  const sphincs_plus_adrs::wots_hash_t adrs{ random_adrs(prng) };
+
+  measure(state, static_cast<int64_t>(len * w + 1), [&]() {
+    sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, adrs, pkey);
+    benchmark::DoNotOptimize(pkey);
+  });
+}
+
+// Benchmark WOTS+ signing of a n -bytes message, whose cost depends on message digits, which are random here.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+wots_sign(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n * len> sig{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+  const sphincs_plus_adrs::wots_hash_t adrs{ random_adrs(prng) };
+
+  measure(state, 1, [&]() {
+    sphincs_plus_wots::sign<n, w, v>(msg, sk_seed, pk_seed, adrs, sig);
+    benchmark::DoNotOptimize(sig);
+  });
+}
+
+// Benchmark recovering WOTS+ public key from signature, which is what verification of each HyperTree layer waits on,
+// reporting occupancy of lanes, in which uneven chains are walked together.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+wots_pk_from_sig(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n * len> sig{};
+  std::array<uint8_t, n> pkey{};
+
+  prng::prng_t prng;
+  randomize(prng, pk_seed, msg, sig);
+  const sphincs_plus_adrs::wots_hash_t adrs{ random_adrs(prng) };
+
+  sphincs_plus_wots::lane_stats_t stats{};
+
+  measure(state, 1, [&]() {
+    sphincs_plus_wots::pk_from_sig<n, w, v>(sig, msg, pk_seed, adrs, pkey, &stats);
+    benchmark::DoNotOptimize(pkey);
+  });
+
+  state.counters["lane_occupancy"] = stats.get_occupancy();
+}
+
+// Benchmark computing root of a XMSS tree of height h, using treehash i.e. generating all of its 2^h WOTS+ public keys.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+xmss_treehash(benchmark::State& state)
+{
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> root{};
+
+  prng::prng_t prng;
+  randomize(prng, sk_seed, pk_seed);
+
+  sphincs_plus_adrs::adrs_t adrs{};
+  adrs.set_layer_address(1u);
+  adrs.set_tree_address(prng_u64(prng));
+
+  measure(state, 1, [&]() {
+    sphincs_plus_xmss::pkgen<h, n, w, v>(sk_seed, pk_seed, adrs, root);
+    benchmark::DoNotOptimize(root);
+  });
+}
+
+// Benchmark signing a n -bytes message, using a XMSS tree of height h, at a random leaf.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+xmss_sign(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, (len + h) * n> sig{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+
+  sphincs_plus_adrs::adrs_t adrs{};
+  adrs.set_layer_address(1u);
+  adrs.set_tree_address(prng_u64(prng));
+
+  const uint32_t idx = static_cast<uint32_t>(prng_u64(prng)) & ((1u << h) - 1u);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_xmss::sign<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, sig);
+    benchmark::DoNotOptimize(sig);
+  });
+}
+
+// Benchmark recovering root of a XMSS tree of height h, from a XMSS signature.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+xmss_pk_from_sig(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, (len + h) * n> sig{};
+  std::array<uint8_t, n> root{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+
+  sphincs_plus_adrs::adrs_t adrs{};
+  adrs.set_layer_address(1u);
+  adrs.set_tree_address(prng_u64(prng));
+
+  const uint32_t idx = static_cast<uint32_t>(prng_u64(prng)) & ((1u << h) - 1u);
+  sphincs_plus_xmss::sign<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, sig);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_xmss::pk_from_sig<h, n, w, v>(idx, sig, msg, pk_seed, adrs, root);
+    benchmark::DoNotOptimize(root);
+  });
+}
+
+// Returns FORS address, as used by SPHINCS+ signing, for a random XMSS tree address and leaf index.
+static inline sphincs_plus_adrs::fors_tree_t
+fors_adrs(prng::prng_t& prng)
+{
+  sphincs_plus_adrs::fors_tree_t adrs{};
+
+  adrs.set_layer_address(0u);
+  adrs.set_tree_address(prng_u64(prng));
+  adrs.set_type(sphincs_plus_adrs::type_t::FORS_TREE);
+  adrs.set_keypair_address(static_cast<uint32_t>(prng_u64(prng)) & 0xffu);
+
+  return adrs;
+}
+
+// Benchmark FORS signing of a (k * a + 7) / 8 -bytes message digest, i.e. building k FORS trees of height a.
+template<size_t n, uint32_t a, uint32_t k, sphincs_plus_hashing::variant v>
+static inline void
+fors_sign(benchmark::State& state)
+{
+  std::array<uint8_t, (k * a + 7) / 8> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, k * n * (a + 1)> sig{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+  const auto adrs = fors_adrs(prng);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_fors::sign<n, a, k, v>(msg, sk_seed, pk_seed, adrs, sig);
+    benchmark::DoNotOptimize(sig);
+  });
+}
+
+// Benchmark recovering FORS public key from a FORS signature.
+template<size_t n, uint32_t a, uint32_t k, sphincs_plus_hashing::variant v>
+static inline void
+fors_pk_from_sig(benchmark::State& state)
+{
+  std::array<uint8_t, (k * a + 7) / 8> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, k * n * (a + 1)> sig{};
+  std::array<uint8_t, n> pkey{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+  const auto adrs = fors_adrs(prng);
+
+  sphincs_plus_fors::sign<n, a, k, v>(msg, sk_seed, pk_seed, adrs, sig);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_fors::pk_from_sig<n, a, k, v>(sig, msg, pk_seed, adrs, pkey);
+    benchmark::DoNotOptimize(pkey);
+  });
+}
+
+// Benchmark HyperTree signing of a n -bytes message, at random tree and leaf indices, i.e. d XMSS signatures.
+template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+ht_sign(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, (h + d * len) * n> sig{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+
+  const uint64_t itree = prng_u64(prng) & ((h - h / d) == 64u ? ~0ul : ((1ul << (h - h / d)) - 1ul));
+  const uint32_t ileaf = static_cast<uint32_t>(prng_u64(prng)) & ((1u << (h / d)) - 1u);
+
+  measure(state, 1, [&]() {
+    sphincs_plus_ht::sign<h, d, n, w, v>(msg, sk_seed, pk_seed, itree, ileaf, sig);
+    benchmark::DoNotOptimize(sig);
+  });
+}
+
+// Benchmark HyperTree signature verification, against HyperTree public key, i.e. recovering d XMSS tree roots.
+template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+ht_verify(benchmark::State& state)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> pkey{};
+  std::array<uint8_t, (h + d * len) * n> sig{};
+
+  prng::prng_t prng;
+  randomize(prng, msg, sk_seed, pk_seed);
+
+  const uint64_t itree = prng_u64(prng) & ((h - h / d) == 64u ? ~0ul : ((1ul << (h - h / d)) - 1ul));
+  const uint32_t ileaf = static_cast<uint32_t>(prng_u64(prng)) & ((1u << (h / d)) - 1u);
+
+  sphincs_plus_ht::pkgen<h, d, n, w, v>(sk_seed, pk_seed, pkey);
+  sphincs_plus_ht::sign<h, d, n, w, v>(msg, sk_seed, pk_seed, itree, ileaf, sig);
+
+  bool flg = true;
+
+  measure(state, 1, [&]() {
+    flg &= sphincs_plus_ht::verify<h, d, n, w, v>(msg, sig, pk_seed, itree, ileaf, pkey);
+    benchmark::DoNotOptimize(flg);
+  });
+
+  assert(flg);
+}
+
+// Registers all component-level benchmarks, for given SPHINCS+ parameter set, under name prefix `name`, s.t. they can
+// be selected using `--benchmark_filter`, say `sphincs+-128f-simple/wots_`. H_msg is benchmarked on 32 B, 1 KB and 1 MB
+// messages.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+register_all(const std::string& name)
+{
+  constexpr uint32_t xh = h / d;
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+
+  const auto add = [&](const std::string& routine, auto fn) {
+    return benchmark::RegisterBenchmark((name + "/" + routine).c_str(), fn)
+      ->ComputeStatistics("min", compute_min)
+      ->ComputeStatistics("max", compute_max);
+  };
+
+  add("f", t_l<n, 1, v>);
+  add("h", t_l<n, 2, v>);
+  add("t_len", t_l<n, len, v>);
+  add("prf", prf<n>);
+  add("h_msg", h_msg<n, h, d, a, k>)->Arg(32)->Arg(1l << 10)->Arg(1l << 20)->ArgName("mlen");
+
+  add("wots_chain", wots_chain<n, w, v>);
+  add("wots_pkgen", wots_pkgen<n, w, v>);
+  add("wots_sign", wots_sign<n, w, v>);
+  add("wots_pk_from_sig", wots_pk_from_sig<n, w, v>);
+
+  add("xmss_treehash", xmss_treehash<xh, n, w, v>);
+  add("xmss_sign", xmss_sign<xh, n, w, v>);
+  add("xmss_pk_from_sig", xmss_pk_from_sig<xh, n, w, v>);
+
+  add("fors_sign", fors_sign<n, a, k, v>);
+  add("fors_pk_from_sig", fors_pk_from_sig<n, a, k, v>);
+
+  add("ht_sign", ht_sign<h, d, n, w, v>);
+  add("ht_verify", ht_verify<h, d, n, w, v>);
+
+  return true;
+}
+
+}
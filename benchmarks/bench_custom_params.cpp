@@ -0,0 +1,32 @@
+#include "bench_custom_params.hpp"
+
+using sphincs_plus_custom::params_t;
+using sphincs_plus_hashing::variant;
+
+// Registers keygen, sign and verify benchmarks for a grid of custom parameter sets, at NIST security level 1 ( n = 16 ),
+// sweeping HyperTree height/ # -of layers, along with FORS parameters, across Winternitz parameter w ∈ {4, 16, 256}, so
+// that time of signing/ verification can be compared against signature size, using `make custom_params`.
+static const auto registered = []() {
+  using namespace bench_sphincs_plus_custom_params;
+
+  // Single layer HyperTree
+  register_all<params_t<16, 8, 1, 14, 10, 4, variant::simple>>();
+  register_all<params_t<16, 8, 1, 14, 10, 16, variant::simple>>();
+  register_all<params_t<16, 8, 1, 14, 10, 256, variant::simple>>();
+
+  // Shallow HyperTree, for few-signature keys
+  register_all<params_t<16, 12, 2, 12, 10, 4, variant::simple>>();
+  register_all<params_t<16, 12, 2, 12, 10, 16, variant::simple>>();
+  register_all<params_t<16, 12, 2, 12, 10, 256, variant::simple>>();
+
+  // Moderately deep HyperTree
+  register_all<params_t<16, 24, 3, 12, 12, 4, variant::simple>>();
+  register_all<params_t<16, 24, 3, 12, 12, 16, variant::simple>>();
+  register_all<params_t<16, 24, 3, 12, 12, 256, variant::simple>>();
+
+  register_all<params_t<16, 32, 4, 10, 16, 4, variant::simple>>();
+  register_all<params_t<16, 32, 4, 10, 16, 16, variant::simple>>();
+  register_all<params_t<16, 32, 4, 10, 16, 256, variant::simple>>();
+
+  return true;
+}();
@@ -0,0 +1,80 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "bench_sphincs+.hpp"
+#include "cost_model.hpp"
+#include "sphincs+_custom.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+// Benchmark SPHINCS+ instantiated with custom parameter sets, so that signing/ verification time can be traded off
+// against signature size, say for few-signature keys.
+namespace bench_sphincs_plus_custom_params {
+
+// Returns name of custom parameter set, say `sphincs+-custom/n16-h12-d2-a12-k10-w256-simple`.
+template<typename params>
+static inline std::string
+get_name()
+{
+  return "sphincs+-custom/n" + std::to_string(params::n) + "-h" + std::to_string(params::h) + "-d" + std::to_string(params::d) + "-a" +
+         std::to_string(params::a) + "-k" + std::to_string(params::k) + "-w" + std::to_string(params::w) +
+         (params::v == sphincs_plus_hashing::variant::robust ? "-robust" : "-simple");
+}
+
+// Registers keygen, sign and verify benchmarks of a custom parameter set, each of them reporting signature length, in
+// bytes, as `sig_bytes`, along with Keccak-f[1600] permutations per operation, as per compile-time cost model, as
+// `model_perms`, next to what `bench_sphincs_plus` routines report.
+template<typename params>
+static inline bool
+register_all()
+{
+  namespace cost_model = sphincs_plus_cost_model;
+
+  constexpr size_t n = params::n;
+  constexpr uint32_t h = params::h;
+  constexpr uint32_t d = params::d;
+  constexpr uint32_t a = params::a;
+  constexpr uint32_t k = params::k;
+  constexpr size_t w = params::w;
+  constexpr sphincs_plus_hashing::variant v = params::v;
+  constexpr size_t mlen = 32;
+
+  constexpr auto sig_bytes = static_cast<double>(params::SigLen);
+  constexpr auto keygen_perms = static_cast<double>(cost_model::keygen<n, h, d, a, k, w, v>().permutations);
+  constexpr auto sign_perms = static_cast<double>(cost_model::sign<n, h, d, a, k, w, v>(mlen).permutations);
+  constexpr auto verify_perms = cost_model::verify_cost<n, h, d, a, k, w, v>(mlen).avg_permutations;
+
+  const std::string name = get_name<params>();
+
+  benchmark::RegisterBenchmark((name + "/keygen").c_str(),
+                               [](benchmark::State& state) {
+                                 bench_sphincs_plus::keygen<n, h, d, w, v>(state);
+                                 state.counters["sig_bytes"] = sig_bytes;
+                                 state.counters["model_perms"] = keygen_perms;
+                               })
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  benchmark::RegisterBenchmark((name + "/sign").c_str(),
+                               [](benchmark::State& state) {
+                                 bench_sphincs_plus::sign<n, h, d, a, k, w, v>(state);
+                                 state.counters["sig_bytes"] = sig_bytes;
+                                 state.counters["model_perms"] = sign_perms;
+                               })
+    ->Arg(mlen)
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  benchmark::RegisterBenchmark((name + "/verify").c_str(),
+                               [](benchmark::State& state) {
+                                 bench_sphincs_plus::verify<n, h, d, a, k, w, v>(state);
+                                 state.counters["sig_bytes"] = sig_bytes;
+                                 state.counters["model_perms"] = verify_perms;
+                               })
+    ->Arg(mlen)
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  return true;
+}
+
+}
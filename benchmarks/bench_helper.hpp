@@ -1,6 +1,29 @@
 #pragma once
+#include "counters.hpp"
 #include <algorithm>
+#include <benchmark/benchmark.h>
 #include <vector>
 
 const auto compute_min = [](const std::vector<double>& v) -> double { return *std::min_element(v.begin(), v.end()); };
 const auto compute_max = [](const std::vector<double>& v) -> double { return *std::max_element(v.begin(), v.end()); };
+
+// When built with `-DSPHINCS_PLUS_COUNTERS`, reports hash function calls and Keccak-f[1600] permutations, recorded on
+// benchmarking thread, since `sphincs_plus_counters::reset()` was last called, as per-operation counters, along with
+// achieved permutations per second. Otherwise it does nothing.
+static inline void
+report_hash_counters(benchmark::State& state)
+{
+  if constexpr (sphincs_plus_counters::ENABLED) {
+    using sphincs_plus_counters::hash_t;
+
+    const auto counters = sphincs_plus_counters::get();
+    const auto iters = static_cast<double>(state.iterations());
+
+    state.counters["F/op"] = static_cast<double>(counters.get_calls(hash_t::f)) / iters;
+    state.counters["H/op"] = static_cast<double>(counters.get_calls(hash_t::h)) / iters;
+    state.counters["T_l/op"] = static_cast<double>(counters.get_calls(hash_t::t_l)) / iters;
+    state.counters["PRF/op"] = static_cast<double>(counters.get_calls(hash_t::prf)) / iters;
+    state.counters["perms/op"] = static_cast<double>(counters.permutations) / iters;
+    state.counters["perms/s"] = benchmark::Counter(static_cast<double>(counters.permutations), benchmark::Counter::kIsRate);
+  }
+}
@@ -0,0 +1,46 @@
+#include "bench_helper.hpp"
+#include "bench_keccak.hpp"
+
+// Keccak-f[1600] permutation, on 1, 2 and 3 interleaved states, with and without lane complementing
+BENCHMARK(bench_sphincs_plus_keccak::permute<1, false>)
+  ->Name("keccak-f[1600]/permute/x1")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::permute<1, true>)
+  ->Name("keccak-f[1600]/permute/x1/lane_complementing")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::permute<2, false>)
+  ->Name("keccak-f[1600]/permute/x2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::permute<2, true>)
+  ->Name("keccak-f[1600]/permute/x2/lane_complementing")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::permute<3, false>)
+  ->Name("keccak-f[1600]/permute/x3")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::permute<3, true>)
+  ->Name("keccak-f[1600]/permute/x3/lane_complementing")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+// Single-block SHAKE256, on input of F, using sha3 library and in-tree permutation
+BENCHMARK(bench_sphincs_plus_keccak::shake256_block<16, false>)
+  ->Name("sphincs+-128-simple/shake256_block/sha3")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::shake256_block<16, true>)
+  ->Name("sphincs+-128-simple/shake256_block/in_tree")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::shake256_block<32, false>)
+  ->Name("sphincs+-256-simple/shake256_block/sha3")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_keccak::shake256_block<32, true>)
+  ->Name("sphincs+-256-simple/shake256_block/in_tree")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
@@ -0,0 +1,106 @@
+#pragma once
+#include "keccak.hpp"
+#include "prng.hpp"
+#include "shake256.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark in-tree scalar Keccak-f[1600] permutation
+namespace bench_sphincs_plus_keccak {
+
+// Benchmark applying Keccak-f[1600] permutation on `ways` -many independent states, interleaved, with or without lane
+// complementing, reporting cost per permutation.
+template<size_t ways, bool lane_complementing>
+static inline void
+permute(benchmark::State& state)
+{
+  std::array<sphincs_plus_keccak::state_t, ways> st{};
+
+  prng::prng_t prng;
+  for (auto& s : st) {
+    std::array<uint8_t, sizeof(s)> bytes{};
+    prng.read(bytes);
+    std::memcpy(s.data(), bytes.data(), bytes.size());
+  }
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_keccak::permute<ways, lane_complementing>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(ways) * state.iterations());
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc/perm"] = static_cast<double>(total_ticks) / static_cast<double>(ways);
+#endif
+}
+
+// Benchmark computing n -bytes SHAKE256 digest of n + 32 + n -bytes input, as simple variant of F does, using either
+// incremental SHAKE256 of sha3 library or single-block in-tree SHAKE256, reporting cost per permutation.
+template<size_t n, bool in_tree>
+static inline void
+shake256_block(benchmark::State& state)
+{
+  constexpr size_t ilen = n + 32 + n;
+
+  std::array<uint8_t, ilen> msg{};
+  std::array<uint8_t, n> dig{};
+
+  prng::prng_t prng;
+  prng.read(msg);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    if constexpr (in_tree) {
+      sphincs_plus_keccak::shake256<ilen, n>(msg, dig);
+    } else {
+      shake256::shake256_t hasher;
+
+      hasher.absorb(msg);
+      hasher.finalize();
+      hasher.squeeze(dig);
+    }
+
+    benchmark::DoNotOptimize(dig);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+
+    std::copy(dig.begin(), dig.end(), msg.begin());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc/perm"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Benchmark latency distribution of SPHINCS+ keygen, sign and verify, reporting tail percentiles
+namespace bench_sphincs_plus_latency {
+
+// HDR-style histogram of 64 -bit values, s.t. each recorded value is bucketed with relative error of at max 2^-(p-1).
+// Values below 2^p are kept exactly, while each of following power of 2 ranges is split into 2^(p-1) -many equal width
+// buckets, so that memory usage stays small, irrespective of range of recorded values.
+template<size_t p = 10>
+struct histogram_t
+{
+private:
+  static constexpr uint64_t SUB_BUCKET_CNT = 1ul << p;
+  static constexpr uint64_t HALF_BUCKET_CNT = SUB_BUCKET_CNT >> 1;
+  static constexpr size_t BUCKET_CNT = SUB_BUCKET_CNT + (64 - p) * HALF_BUCKET_CNT;
+
+  std::vector<uint64_t> counts = std::vector<uint64_t>(BUCKET_CNT, 0);
+  uint64_t total = 0;
+  uint64_t max = 0;
+
+  // Returns index of bucket, holding value `val`.
+  static inline size_t bucket_of(const uint64_t val)
+  {
+    if (val < SUB_BUCKET_CNT) {
+      return static_cast<size_t>(val);
+    }
+
+    const size_t shift = static_cast<size_t>(std::bit_width(val)) - p;
+    return SUB_BUCKET_CNT + (shift - 1) * HALF_BUCKET_CNT + static_cast<size_t>((val >> shift) - HALF_BUCKET_CNT);
+  }
+
+  // Returns largest value, which falls in bucket at index `idx`.
+  static inline uint64_t highest_of(const size_t idx)
+  {
+    if (idx < SUB_BUCKET_CNT) {
+      return static_cast<uint64_t>(idx);
+    }
+
+    const size_t shift = (idx - SUB_BUCKET_CNT) / HALF_BUCKET_CNT + 1;
+    const uint64_t sub = (idx - SUB_BUCKET_CNT) % HALF_BUCKET_CNT + HALF_BUCKET_CNT;
+    return ((sub + 1) << shift) - 1;
+  }
+
+public:
+  // Records a single value.
+  inline void record(const uint64_t val)
+  {
+    counts[bucket_of(val)]++;
+    total++;
+    max = std::max(max, val);
+  }
+
+  inline uint64_t get_count() const { return total; }
+  inline uint64_t get_max() const { return max; }
+
+  // Returns value at given percentile ( in [0, 100] ) i.e. largest value, equivalent to the one s.t. `percentile` % of
+  // recorded values are less than or equal to it. Returns 0, if nothing is recorded yet.
+  inline uint64_t value_at(const double percentile) const
+  {
+    if (total == 0) {
+      return 0;
+    }
+
+    const double frac = std::clamp(percentile, 0., 100.) / 100.;
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(frac * static_cast<double>(total))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+      seen += counts[i];
+      if (seen >= target) {
+        return std::min(highest_of(i), max);
+      }
+    }
+
+    return max;
+  }
+};
+
+// Repeatedly calls `fn`, passing it iteration index, recording wall-clock latency of each call, in nanoseconds, into an
+// HDR-style histogram. Reported counters `p50`, `p90`, `p99`, `p99.9` and `max` are latencies in nanoseconds, showing up
+// in both tabular and JSON output.
+template<typename fn_t>
+static inline void
+measure(benchmark::State& state, fn_t&& fn)
+{
+  histogram_t hist;
+  size_t idx = 0;
+
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+
+    fn(idx++);
+    benchmark::ClobberMemory();
+
+    const auto end = std::chrono::steady_clock::now();
+    hist.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  state.counters["p50"] = static_cast<double>(hist.value_at(50.));
+  state.counters["p90"] = static_cast<double>(hist.value_at(90.));
+  state.counters["p99"] = static_cast<double>(hist.value_at(99.));
+  state.counters["p99.9"] = static_cast<double>(hist.value_at(99.9));
+  state.counters["max"] = static_cast<double>(hist.get_max());
+}
+
+// # -of random seeds/ messages, cycled through, while benchmarking key generation and signing
+constexpr size_t INPUT_CNT = 64;
+
+// # -of random (message, signature) pairs, cycled through, while benchmarking verification. Kept small, as each of
+// them needs to be signed before benchmarking starts.
+constexpr size_t SIGNED_CNT = 8;
+
+// Benchmark latency distribution of SPHINCS+ key generation, using random seeds.
+template<size_t n, uint32_t h, uint32_t d, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+keygen(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+
+  std::vector<uint8_t> seeds(INPUT_CNT * 3 * n, 0);
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+
+  auto _seeds = std::span(seeds);
+
+  prng::prng_t prng;
+  prng.read(_seeds);
+
+  measure(state, [&](const size_t i) {
+    auto seed = _seeds.subspan((i % INPUT_CNT) * 3 * n, 3 * n);
+
+    sphincs_plus::keygen<n, h, d, w, v>(std::span<const uint8_t, n>(seed.subspan(0, n)),
+                                        std::span<const uint8_t, n>(seed.subspan(n, n)),
+                                        std::span<const uint8_t, n>(seed.subspan(2 * n, n)),
+                                        skey,
+                                        pkey);
+    benchmark::DoNotOptimize(pkey);
+  });
+}
+
+// Benchmark latency distribution of SPHINCS+ signing, using random messages of mlen -bytes.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+sign(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msgs(INPUT_CNT * mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msgs = std::span(msgs);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msgs);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+
+  measure(state, [&](const size_t i) {
+    sphincs_plus::sign<n, h, d, a, k, w, v>(_msgs.subspan((i % INPUT_CNT) * mlen, mlen), skey, {}, _sig);
+    benchmark::DoNotOptimize(_sig);
+  });
+}
+
+// Benchmark latency distribution of SPHINCS+ signature verification, using signatures over random messages of mlen
+// -bytes.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msgs(SIGNED_CNT * mlen, 0);
+  std::vector<uint8_t> sigs(SIGNED_CNT * siglen, 0);
+
+  auto _msgs = std::span(msgs);
+  auto _sigs = std::span(sigs);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msgs);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+
+  for (size_t i = 0; i < SIGNED_CNT; i++) {
+    sphincs_plus::sign<n, h, d, a, k, w, v>(_msgs.subspan(i * mlen, mlen), skey, {}, std::span<uint8_t, siglen>(_sigs.subspan(i * siglen, siglen)));
+  }
+
+  bool flag = true;
+  measure(state, [&](const size_t i) {
+    const size_t j = i % SIGNED_CNT;
+
+    flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(_msgs.subspan(j * mlen, mlen), std::span<const uint8_t, siglen>(_sigs.subspan(j * siglen, siglen)), pkey);
+    benchmark::DoNotOptimize(flag);
+  });
+
+  assert(flag);
+}
+
+// Registers latency distribution benchmarks of key generation, signing and verification, for given SPHINCS+ parameter
+// set, under name prefix `name`, say `sphincs+-128f-simple/sign_latency`. For reaching far into the tail, run them
+// long enough, using `--benchmark_min_time`, as p99.9 needs at least 1000 operations.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+register_all(const std::string& name)
+{
+  const auto add = [&](const std::string& routine, auto fn) {
+    return benchmark::RegisterBenchmark((name + "/" + routine).c_str(), fn)
+      ->UseRealTime()
+      ->ComputeStatistics("min", compute_min)
+      ->ComputeStatistics("max", compute_max);
+  };
+
+  add("keygen_latency", keygen<n, h, d, w, v>);
+  add("sign_latency", sign<n, h, d, a, k, w, v>)->Arg(32)->ArgName("mlen");
+  add("verify_latency", verify<n, h, d, a, k, w, v>)->Arg(32)->ArgName("mlen");
+
+  return true;
+}
+
+}
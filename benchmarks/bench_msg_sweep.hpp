@@ -0,0 +1,196 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "cost_model.hpp"
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Benchmark SPHINCS+ signing and verification, while sweeping message length, so that it's visible beyond which length
+// hashing of message ( by PRF_msg and H_msg ) starts to dominate fixed cost of FORS and HyperTree.
+namespace bench_sphincs_plus_msg_sweep {
+
+// Smallest and largest message length, in bytes, swept over, growing 32 times at each step
+constexpr int64_t MIN_MLEN = 32;
+constexpr int64_t MAX_MLEN = 1l << 30;
+constexpr int MLEN_MULTIPLIER = 32;
+
+// Fills mlen -bytes message with a pseudo-random 4 KB block, repeated, as generating GBs of pseudo-random bytes would
+// only slow down benchmark setup.
+static inline std::vector<uint8_t>
+random_message(const size_t mlen)
+{
+  std::array<uint8_t, 4096> block{};
+
+  prng::prng_t prng;
+  prng.read(block);
+
+  std::vector<uint8_t> msg(mlen, 0);
+  for (size_t off = 0; off < mlen; off += block.size()) {
+    const size_t cnt = std::min(block.size(), mlen - off);
+    std::copy_n(block.begin(), cnt, msg.begin() + static_cast<std::ptrdiff_t>(off));
+  }
+
+  return msg;
+}
+
+// Repeatedly calls `fn`, reporting bytes/s of message, along with
+//
+// - msg_share       : share of Keccak-f[1600] permutations spent on hashing message, as per compile-time cost model,
+//                     given total and message-independent permutations per operation
+// - crossover       : message length, in bytes, beyond which message hashing takes more permutations than the rest
+// - msg_time_share  : share of time spent on hashing message, measured against the run with smallest message, when
+//                     it was run earlier, in same process
+//
+// `baseline` remembers average time per operation, in seconds, of the run with smallest message.
+template<typename fn_t>
+static inline void
+measure(benchmark::State& state, const double total_perms, const double fixed_perms, const double crossover, std::atomic<double>& baseline, fn_t&& fn)
+{
+  const int64_t mlen = state.range();
+  const auto start = std::chrono::steady_clock::now();
+
+  for (auto _ : state) {
+    fn();
+    benchmark::ClobberMemory();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  const double secs = std::chrono::duration<double>(end - start).count() / static_cast<double>(state.iterations());
+
+  if (mlen == MIN_MLEN) {
+    baseline.store(secs);
+  }
+
+  state.SetBytesProcessed(mlen * state.iterations());
+  state.SetItemsProcessed(state.iterations());
+
+  state.counters["msg_share"] = (total_perms - fixed_perms) / total_perms;
+  state.counters["crossover"] = crossover;
+
+  const double fixed_secs = baseline.load();
+  if (fixed_secs > 0.) {
+    state.counters["msg_time_share"] = std::max(0., 1. - fixed_secs / secs);
+  }
+}
+
+// Benchmark SPHINCS+ signing of an mlen -bytes message. Message is hashed twice, by PRF_msg and H_msg.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+sign(benchmark::State& state)
+{
+  namespace cost_model = sphincs_plus_cost_model;
+
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = static_cast<size_t>(state.range());
+
+  // Each byte of message costs 2/136 permutations, as it's absorbed by both PRF_msg and H_msg
+  constexpr double fixed_perms = static_cast<double>(cost_model::sign<n, h, d, a, k, w, v>(0).permutations);
+  constexpr double crossover = fixed_perms * static_cast<double>(sphincs_plus_keccak::SHAKE256_RATE) / 2.;
+  const double total_perms = static_cast<double>(cost_model::sign<n, h, d, a, k, w, v>(mlen).permutations);
+
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg = random_message(mlen);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+
+  measure(state, total_perms, fixed_perms, crossover, baseline, [&]() {
+    sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+    benchmark::DoNotOptimize(_sig);
+  });
+}
+
+// Benchmark SPHINCS+ verification of a signature over an mlen -bytes message. Message is hashed once, by H_msg.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state)
+{
+  namespace cost_model = sphincs_plus_cost_model;
+
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = static_cast<size_t>(state.range());
+
+  // Verification cost depends on message digits, so average of it is used, as per cost model
+  constexpr auto fixed = cost_model::verify_cost<n, h, d, a, k, w, v>(0);
+  constexpr double fixed_perms = fixed.avg_permutations;
+  constexpr double crossover = fixed_perms * static_cast<double>(sphincs_plus_keccak::SHAKE256_RATE);
+  const double total_perms = cost_model::verify_cost<n, h, d, a, k, w, v>(mlen).avg_permutations;
+
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg = random_message(mlen);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+
+  bool flag = true;
+  measure(state, total_perms, fixed_perms, crossover, baseline, [&]() {
+    flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig, pkey);
+    benchmark::DoNotOptimize(flag);
+  });
+
+  assert(flag);
+}
+
+// Registers message length sweeping benchmarks of signing and verification, for given SPHINCS+ parameter set, under
+// name prefix `name`, say `sphincs+-128f-simple/sign_msg_sweep/mlen:1048576`. Message length grows from 32 B to 1 GB,
+// so they are best run selectively, using `make msg_sweep`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+register_all(const std::string& name)
+{
+  const auto add = [&](const std::string& routine, auto fn) {
+    return benchmark::RegisterBenchmark((name + "/" + routine).c_str(), fn)
+      ->RangeMultiplier(MLEN_MULTIPLIER)
+      ->Range(MIN_MLEN, MAX_MLEN)
+      ->ArgName("mlen")
+      ->UseRealTime()
+      ->ComputeStatistics("min", compute_min)
+      ->ComputeStatistics("max", compute_max);
+  };
+
+  add("sign_msg_sweep", sign<n, h, d, a, k, w, v>);
+  add("verify_msg_sweep", verify<n, h, d, a, k, w, v>);
+
+  return true;
+}
+
+}
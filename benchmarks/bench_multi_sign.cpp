@@ -0,0 +1,26 @@
+#include "bench_helper.hpp"
+#include "bench_multi_sign.hpp"
+
+// Batch sizes vary from 1 to 1K messages, each message being 32 -bytes. Compare reported messages/s against
+// regular signing benchmark of same parameter set.
+
+BENCHMARK(bench_sphincs_plus_multi::sign<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128s-simple/multi_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 10, 4), { 32 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_multi::sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128f-simple/multi_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 10, 4), { 32 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_multi::sign<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-192f-simple/multi_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 10, 4), { 32 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_multi::sign<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256f-simple/multi_sign")
+  ->ArgsProduct({ benchmark::CreateRange(1, 1 << 10, 4), { 32 } })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
@@ -0,0 +1,88 @@
+#pragma once
+#include "multi_sign.hpp"
+#include "prng.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark SPHINCS+ Locality-aware Signing of Many Messages
+namespace bench_sphincs_plus_multi {
+
+// Benchmark signing `state.range(0)` -many messages, each of `state.range(1)` -bytes, producing one regular SPHINCS+
+// signature per message, while sharing XMSS trees among messages. Throughput is reported in terms of messages signed
+// per second, which makes it easy to compare amortised cost of each signature, against batch size.
+template<const size_t n,
+         const uint32_t h,
+         const uint32_t d,
+         const uint32_t a,
+         const uint32_t k,
+         const size_t w,
+         const sphincs_plus_hashing::variant v>
+static inline void
+sign(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t msg_cnt = static_cast<size_t>(state.range(0));
+  const size_t mlen = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(msg_cnt * mlen, 0);
+  std::vector<uint8_t> sigs(msg_cnt * siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _sigs = std::span(sigs);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+
+  std::vector<std::span<const uint8_t>> batch;
+  for (size_t i = 0; i < msg_cnt; i++) {
+    batch.push_back(_msgs.subspan(i * mlen, mlen));
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_multi::sign<n, h, d, a, k, w, v>(batch, _skey, {}, _sigs);
+
+    benchmark::DoNotOptimize(_msgs);
+    benchmark::DoNotOptimize(_skey);
+    benchmark::DoNotOptimize(_sigs);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(msg_cnt) * state.iterations());
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc/msg"] = static_cast<double>(total_ticks) / static_cast<double>(msg_cnt);
+#endif
+}
+
+}
@@ -0,0 +1,29 @@
+#include "bench_helper.hpp"
+#include "bench_node_cache.hpp"
+
+// Verification of a pool of signatures, under same public key, with ( = 1 ) and without ( = 0 ) verified-node cache
+
+BENCHMARK(bench_sphincs_plus_node_cache::verify<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128s-simple/verify_node_cache")
+  ->ArgsProduct({ { 8 }, { 0, 1 } })
+  ->ArgNames({ "sigs", "cache" })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_node_cache::verify<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128f-simple/verify_node_cache")
+  ->ArgsProduct({ { 64 }, { 0, 1 } })
+  ->ArgNames({ "sigs", "cache" })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_node_cache::verify<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-192f-simple/verify_node_cache")
+  ->ArgsProduct({ { 64 }, { 0, 1 } })
+  ->ArgNames({ "sigs", "cache" })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_node_cache::verify<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256f-simple/verify_node_cache")
+  ->ArgsProduct({ { 64 }, { 0, 1 } })
+  ->ArgNames({ "sigs", "cache" })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
@@ -0,0 +1,98 @@
+#pragma once
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark SPHINCS+ Verification, with Verified-node Cache
+namespace bench_sphincs_plus_node_cache {
+
+// Benchmark verification of a pool of SPHINCS+ signatures, all under same public key, in round-robin order, with or
+// without verified-node cache. As cache is filled during the first round, this benchmark reports steady state cost.
+//
+// Arguments are expected in order ( # -of signatures in pool, whether to use cache ).
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  constexpr size_t mlen = 32;
+
+  const size_t sig_cnt = static_cast<size_t>(state.range(0));
+  const bool use_cache = state.range(1) != 0;
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(sig_cnt * mlen, 0);
+  std::vector<uint8_t> sigs(sig_cnt * siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _sigs = std::span(sigs);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+
+  for (size_t i = 0; i < sig_cnt; i++) {
+    auto msg = _msgs.subspan(i * mlen, mlen);
+    auto sig = std::span<uint8_t, siglen>(_sigs.subspan(i * siglen, siglen));
+
+    sphincs_plus::sign<n, h, d, a, k, w, v>(msg, _skey, {}, sig);
+  }
+
+  sphincs_plus_node_cache::node_cache_t<h, d, n, w, v> cache(_pkey.template subspan<0, n>(), _pkey.template subspan<n, n>());
+  auto _cache = use_cache ? &cache : nullptr;
+
+  size_t idx = 0;
+  bool flag = true;
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+    auto msg = _msgs.subspan(idx * mlen, mlen);
+    auto sig = std::span<const uint8_t, siglen>(_sigs.subspan(idx * siglen, siglen));
+
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(msg, sig, _pkey, _cache);
+
+    benchmark::DoNotOptimize(flag);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+
+    idx = (idx + 1) % sig_cnt;
+  }
+
+  assert(flag);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = cache.get_hit_rate();
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
@@ -0,0 +1,27 @@
+#include "bench_helper.hpp"
+#include "bench_prehash.hpp"
+#include <thread>
+
+// Message length ( = 64 MB ), to be pre-hashed
+constexpr int64_t MLEN = 1l << 26;
+
+// Registers ParallelHash benchmarks for a few block lengths, with # -of threads doubling from 1 to # -of available
+// cores, so that achieved bytes/s can be compared against core count.
+static const auto registered = []() {
+  const int64_t max_threads = std::max<int64_t>(1, static_cast<int64_t>(std::thread::hardware_concurrency()));
+
+  std::vector<int64_t> threads;
+  for (int64_t t = 1; t < max_threads; t <<= 1) {
+    threads.push_back(t);
+  }
+  threads.push_back(max_threads);
+
+  benchmark::RegisterBenchmark("sphincs+-prehash/parallel_hash", bench_sphincs_plus_prehash::parallel_hash)
+    ->ArgsProduct({ { MLEN }, { 1l << 12, 1l << 13, 1l << 16, 1l << 20 }, threads })
+    ->ArgNames({ "mlen", "block_len", "threads" })
+    ->UseRealTime()
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  return true;
+}();
@@ -0,0 +1,59 @@
+#pragma once
+#include "prehash.hpp"
+#include "prng.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark SPHINCS+ Message Pre-hashing
+namespace bench_sphincs_plus_prehash {
+
+// Benchmark ParallelHash based message pre-hashing, for a message of fixed length, while varying message block length
+// and number of threads used for compressing blocks.
+//
+// Arguments are expected in order ( message length in bytes, block length in bytes, # -of threads ).
+static inline void
+parallel_hash(benchmark::State& state)
+{
+  const size_t mlen = static_cast<size_t>(state.range(0));
+  const size_t block_len = static_cast<size_t>(state.range(1));
+  const size_t thread_cnt = static_cast<size_t>(state.range(2));
+
+  std::vector<uint8_t> msg(mlen, 0);
+  std::array<uint8_t, 64> dig{};
+
+  auto _msg = std::span(msg);
+
+  prng::prng_t prng;
+  prng.read(_msg);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_prehash::parallel_hash<dig.size()>(_msg, dig, block_len, thread_cnt);
+
+    benchmark::DoNotOptimize(_msg);
+    benchmark::DoNotOptimize(dig);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(mlen) * state.iterations());
+  state.counters["threads"] = static_cast<double>(thread_cnt);
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
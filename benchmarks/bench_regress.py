@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""
+Benchmark regression harness for SPHINCS+-SHAKE.
+
+Runs the benchmark binary ( build/bench.out ) with repetitions, keeping every
+repetition in JSON output, and either saves it as baseline of this machine, or
+compares it against saved baseline, using one-sided Mann-Whitney U test on
+repetitions of each benchmark.
+
+A benchmark is flagged as regressed, when its median got slower by more than
+`--threshold` and the slowdown is statistically significant at `--alpha`.
+Improvements are flagged the same way. Exit status is 1, if anything regressed.
+
+Usage
+
+    # Save baseline of this machine, in benchmarks/baselines/<machine>.json
+    python3 benchmarks/bench_regress.py save --filter "sphincs\\+-128f-simple/(sign|verify)/"
+
+    # Compare a fresh run against it
+    python3 benchmarks/bench_regress.py compare --filter "sphincs\\+-128f-simple/(sign|verify)/"
+
+    # Compare two existing result files
+    python3 benchmarks/bench_regress.py compare --baseline old.json --results new.json
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_BINARY = os.path.join(HERE, "..", "build", "bench.out")
+DEFAULT_BASELINE_DIR = os.path.join(HERE, "baselines")
+
+# Multipliers for converting google-benchmark time units to nanoseconds
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def machine_id():
+    """Identifies this machine by hostname and CPU model, so that baselines of different machines are never compared."""
+    cpu = platform.processor() or platform.machine()
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpu = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+
+    return re.sub(r"[^A-Za-z0-9]+", "-", f"{platform.node()}-{cpu}").strip("-").lower()
+
+
+def run_benchmarks(binary, bench_filter, repetitions, min_time, out):
+    """Runs benchmark binary, writing every repetition of each selected benchmark to `out`, in JSON format."""
+    cmd = [
+        binary,
+        f"--benchmark_filter={bench_filter}",
+        f"--benchmark_repetitions={repetitions}",
+        f"--benchmark_min_time={min_time}",
+        "--benchmark_enable_random_interleaving=true",
+        "--benchmark_report_aggregates_only=false",
+        "--benchmark_display_aggregates_only=true",
+        f"--benchmark_out={out}",
+        "--benchmark_out_format=json",
+    ]
+    subprocess.run(cmd, check=True)
+
+
+def load_samples(path, metric):
+    """
+    Loads JSON output of google-benchmark, returning its context and a mapping from benchmark name to list of
+    per-repetition values of `metric`, which is either `real_time`, `cpu_time` ( both in nanoseconds ) or name of a
+    user counter, say `rdtsc`.
+    """
+    with open(path) as f:
+        doc = json.load(f)
+
+    samples = {}
+    for bench in doc.get("benchmarks", []):
+        if bench.get("run_type", "iteration") != "iteration" or bench.get("error_occurred", False):
+            continue
+
+        if metric in ("real_time", "cpu_time"):
+            value = bench[metric] * TIME_UNITS[bench.get("time_unit", "ns")]
+        elif metric in bench:
+            value = bench[metric]
+        else:
+            continue
+
+        name = bench.get("run_name", bench["name"])
+        samples.setdefault(name, []).append(float(value))
+
+    return doc.get("context", {}), samples
+
+
+def median(xs):
+    ys = sorted(xs)
+    mid = len(ys) // 2
+    return ys[mid] if len(ys) & 1 else (ys[mid - 1] + ys[mid]) / 2
+
+
+def mann_whitney_greater(xs, ys):
+    """
+    One-sided Mann-Whitney U test, returning p-value of alternative hypothesis that values of `ys` tend to be larger than
+    values of `xs`. Uses normal approximation, with tie and continuity correction, which is adequate for 5 or more
+    repetitions on each side.
+    """
+    n1, n2 = len(xs), len(ys)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    # Rank pooled samples, averaging ranks of ties
+    pooled = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    ranks = [0.0] * len(pooled)
+    ties = 0.0
+
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+
+        t = j - i + 1
+        ties += t**3 - t
+        i = j + 1
+
+    r2 = sum(r for r, (_, grp) in zip(ranks, pooled) if grp == 1)
+    u2 = r2 - n2 * (n2 + 1) / 2
+
+    n = n1 + n2
+    mean = n1 * n2 / 2
+    var = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+
+    z = (u2 - mean - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def compare(base, new, threshold, alpha):
+    """Compares samples of each benchmark present in both runs, returning rows of summary table."""
+    rows = []
+    for name in sorted(set(base) & set(new)):
+        b, c = base[name], new[name]
+        mb, mc = median(b), median(c)
+        change = (mc - mb) / mb if mb else 0.0
+
+        p_slower = mann_whitney_greater(b, c)
+        p_faster = mann_whitney_greater(c, b)
+
+        if change > threshold and p_slower < alpha:
+            verdict, p = "REGRESSION", p_slower
+        elif change < -threshold and p_faster < alpha:
+            verdict, p = "improvement", p_faster
+        else:
+            verdict, p = "ok", min(p_slower, p_faster)
+
+        rows.append((name, mb, mc, change, p, len(b), len(c), verdict))
+
+    return rows
+
+
+def print_table(rows, metric):
+    header = ("benchmark", f"base {metric}", f"new {metric}", "change", "p-value", "n", "verdict")
+    lines = [
+        (name, f"{mb:.4g}", f"{mc:.4g}", f"{change * 100:+.2f}%", f"{p:.4f}", f"{nb}/{nc}", verdict)
+        for (name, mb, mc, change, p, nb, nc, verdict) in rows
+    ]
+
+    widths = [max(len(str(x)) for x in col) for col in zip(header, *lines)]
+    fmt = " | ".join("{:<%d}" % w for w in widths)
+
+    print(fmt.format(*header))
+    print("-+-".join("-" * w for w in widths))
+    for line in lines:
+        print(fmt.format(*line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Save and compare SPHINCS+ benchmark baselines")
+    parser.add_argument("command", choices=["save", "compare"])
+    parser.add_argument("--binary", default=DEFAULT_BINARY, help="benchmark binary, built using `make build/bench.out`")
+    parser.add_argument("--filter", default="sphincs\\+-.*/(keygen|sign|verify)(/|$)", help="--benchmark_filter regex")
+    parser.add_argument("--repetitions", type=int, default=10)
+    parser.add_argument("--min-time", default="0.1", help="--benchmark_min_time, per repetition")
+    parser.add_argument("--metric", default="real_time", help="real_time, cpu_time or name of a counter, say rdtsc")
+    parser.add_argument("--threshold", type=float, default=0.05, help="relative change of median, to be flagged")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level of Mann-Whitney U test")
+    parser.add_argument("--baseline-dir", default=DEFAULT_BASELINE_DIR)
+    parser.add_argument("--baseline", help="baseline JSON, defaults to the one saved for this machine")
+    parser.add_argument("--results", help="already collected JSON results, instead of running the binary")
+    args = parser.parse_args()
+
+    baseline = args.baseline or os.path.join(args.baseline_dir, machine_id() + ".json")
+
+    results = args.results
+    if results is None:
+        if args.command == "save":
+            os.makedirs(os.path.dirname(os.path.abspath(baseline)), exist_ok=True)
+            results = baseline
+        else:
+            fd, results = tempfile.mkstemp(suffix=".json")
+            os.close(fd)
+
+        run_benchmarks(args.binary, args.filter, args.repetitions, args.min_time, results)
+
+    if args.command == "save":
+        if os.path.abspath(results) != os.path.abspath(baseline):
+            os.makedirs(os.path.dirname(os.path.abspath(baseline)), exist_ok=True)
+            with open(results) as src, open(baseline, "w") as dst:
+                dst.write(src.read())
+
+        print(f"Saved baseline to {baseline}")
+        return 0
+
+    if not os.path.exists(baseline):
+        print(f"No baseline found at {baseline}, save one first", file=sys.stderr)
+        return 2
+
+    base_ctx, base = load_samples(baseline, args.metric)
+    new_ctx, new = load_samples(results, args.metric)
+
+    if base_ctx.get("host_name") != new_ctx.get("host_name"):
+        print(f"Warning: baseline is from host {base_ctx.get('host_name')}, while results are from {new_ctx.get('host_name')}", file=sys.stderr)
+
+    if args.results is None:
+        os.remove(results)
+
+    rows = compare(base, new, args.threshold, args.alpha)
+    if not rows:
+        print("No benchmark is present in both baseline and results", file=sys.stderr)
+        return 2
+
+    print_table(rows, args.metric)
+
+    regressed = sum(1 for row in rows if row[-1] == "REGRESSION")
+    improved = sum(1 for row in rows if row[-1] == "improvement")
+    print(f"\n{len(rows)} benchmarks compared, {regressed} regressed, {improved} improved ( threshold {args.threshold * 100:.1f}%, alpha {args.alpha} )")
+
+    return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,25 @@
+#include "bench_helper.hpp"
+#include "bench_sig_cache.hpp"
+
+// Repeated verification of same signature, over 32 -bytes message, which hits verified-signature result cache
+
+BENCHMARK(bench_sphincs_plus_sig_cache::verify<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128s-simple/verify_sig_cache")
+  ->Arg(32)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_sig_cache::verify<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-128f-simple/verify_sig_cache")
+  ->Arg(32)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_sig_cache::verify<32, 64, 8, 14, 22, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256s-simple/verify_sig_cache")
+  ->Arg(32)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sphincs_plus_sig_cache::verify<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>)
+  ->Name("sphincs+-256f-simple/verify_sig_cache")
+  ->Arg(32)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
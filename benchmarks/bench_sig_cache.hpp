@@ -0,0 +1,84 @@
+#pragma once
+#include "prng.hpp"
+#include "sig_cache.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark SPHINCS+ Verification, with Verified-signature Result Cache
+namespace bench_sphincs_plus_sig_cache {
+
+// Benchmark repeated verification of same SPHINCS+ signature, which hits verified-signature result cache, after the
+// very first verification.
+//
+// Argument is expected to be message length in bytes.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = static_cast<size_t>(state.range(0));
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig);
+
+  sphincs_plus_sig_cache::cache_t cache;
+  bool flag = sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    flag &= sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache);
+
+    benchmark::DoNotOptimize(flag);
+    benchmark::DoNotOptimize(_msg);
+    benchmark::DoNotOptimize(_sig);
+    benchmark::DoNotOptimize(_pkey);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  assert(flag);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = cache.get_hit_rate();
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
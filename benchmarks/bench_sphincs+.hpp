@@ -1,4 +1,6 @@
 #pragma once
+#include "bench_helper.hpp"
+#include "perf_events.hpp"
 #include "prng.hpp"
 #include "sphincs+.hpp"
 #include "x86_64_cpu_ticks.hpp"
@@ -37,6 +39,11 @@ keygen(benchmark::State& state)
   uint64_t total_ticks = 0ul;
 #endif
 
+  sphincs_plus_counters::reset();
+
+  bench_perf_events::perf_events_t perf;
+  perf.start();
+
   for (auto _ : state) {
 #ifdef __x86_64__
     const uint64_t start = cpu_ticks();
@@ -57,7 +64,11 @@ keygen(benchmark::State& state)
 #endif
   }
 
+  perf.stop();
+
   state.SetItemsProcessed(state.iterations());
+  report_hash_counters(state);
+  perf.report(state);
 
 #ifdef __x86_64__
   total_ticks /= static_cast<uint64_t>(state.iterations());
@@ -113,6 +124,11 @@ sign(benchmark::State& state)
   uint64_t total_ticks = 0ul;
 #endif
 
+  sphincs_plus_counters::reset();
+
+  bench_perf_events::perf_events_t perf;
+  perf.start();
+
   for (auto _ : state) {
 #ifdef __x86_64__
     const uint64_t start = cpu_ticks();
@@ -138,7 +154,11 @@ sign(benchmark::State& state)
 #endif
   }
 
+  perf.stop();
+
   state.SetItemsProcessed(state.iterations());
+  report_hash_counters(state);
+  perf.report(state);
 
 #ifdef __x86_64__
   total_ticks /= static_cast<uint64_t>(state.iterations());
@@ -200,6 +220,11 @@ verify(benchmark::State& state)
   uint64_t total_ticks = 0ul;
 #endif
 
+  sphincs_plus_counters::reset();
+
+  bench_perf_events::perf_events_t perf;
+  perf.start();
+
   bool flag = true;
   for (auto _ : state) {
 #ifdef __x86_64__
@@ -221,7 +246,11 @@ verify(benchmark::State& state)
   }
 
   assert(flag);
+  perf.stop();
+
   state.SetItemsProcessed(state.iterations());
+  report_hash_counters(state);
+  perf.report(state);
 
 #ifdef __x86_64__
   total_ticks /= static_cast<uint64_t>(state.iterations());
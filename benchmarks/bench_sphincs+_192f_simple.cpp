@@ -1,5 +1,10 @@
 #include "bench_helper.hpp"
+#include "bench_cold_cache.hpp"
+#include "bench_components.hpp"
+#include "bench_latency.hpp"
+#include "bench_msg_sweep.hpp"
 #include "bench_sphincs+.hpp"
+#include "bench_throughput.hpp"
 
 BENCHMARK(bench_sphincs_plus::keygen<24, 66, 22, 16, sphincs_plus_hashing::variant::simple>)
   ->Name("sphincs+-192f-simple/keygen")
@@ -15,3 +20,18 @@ BENCHMARK(bench_sphincs_plus::verify<24, 66, 22, 8, 33, 16, sphincs_plus_hashing
   ->Arg(32)
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
+
+// Component-level benchmarks, find them in bench_components.hpp
+static const bool registered = bench_sphincs_plus_components::register_all<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>("sphincs+-192f-simple");
+
+// Multi-threaded throughput benchmarks, find them in bench_throughput.hpp
+static const bool throughput_registered = bench_sphincs_plus_throughput::register_all<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>("sphincs+-192f-simple");
+
+// Latency distribution benchmarks, find them in bench_latency.hpp
+static const bool latency_registered = bench_sphincs_plus_latency::register_all<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>("sphincs+-192f-simple");
+
+// Message length sweeping benchmarks, find them in bench_msg_sweep.hpp
+static const bool msg_sweep_registered = bench_sphincs_plus_msg_sweep::register_all<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>("sphincs+-192f-simple");
+
+// Warm and cold cache benchmarks, find them in bench_cold_cache.hpp
+static const bool cold_cache_registered = bench_sphincs_plus_cold_cache::register_all<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>("sphincs+-192f-simple");
@@ -0,0 +1,246 @@
+#pragma once
+#include "bench_helper.hpp"
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Benchmark how throughput of SPHINCS+ signing and verification scales, with # -of concurrently working threads
+namespace bench_sphincs_plus_throughput {
+
+// Returns indices of CPUs, calling process is allowed to run on, in increasing order.
+static inline std::vector<int>
+allowed_cpus()
+{
+  std::vector<int> cpus;
+
+#if defined __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+      if (CPU_ISSET(i, &set)) {
+        cpus.push_back(i);
+      }
+    }
+  }
+#endif
+
+  return cpus;
+}
+
+// Pins calling thread to a single CPU, for its lifetime, restoring previous affinity on destruction, as benchmarking
+// thread 0 is the main thread, which keeps running other benchmarks. Does nothing when `enabled` is false or when
+// thread affinity can't be set on this platform.
+struct pin_guard_t
+{
+private:
+  bool pinned = false;
+
+#if defined __linux__
+  cpu_set_t prev;
+#endif
+
+public:
+  inline pin_guard_t(const bool enabled, const size_t thread_idx)
+  {
+#if defined __linux__
+    static const std::vector<int> cpus = allowed_cpus();
+    if (!enabled || cpus.empty()) {
+      return;
+    }
+
+    CPU_ZERO(&prev);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(prev), &prev) != 0) {
+      return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[thread_idx % cpus.size()], &set);
+
+    pinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)enabled;
+    (void)thread_idx;
+#endif
+  }
+
+  inline ~pin_guard_t()
+  {
+#if defined __linux__
+    if (pinned) {
+      pthread_setaffinity_np(pthread_self(), sizeof(prev), &prev);
+    }
+#endif
+  }
+
+  inline bool is_pinned() const { return pinned; }
+
+  pin_guard_t(const pin_guard_t&) = delete;
+  pin_guard_t& operator=(const pin_guard_t&) = delete;
+};
+
+// Repeatedly calls `fn`, on each of `state.threads()` -many concurrently working threads, reporting
+//
+// - ops/s        : aggregate # -of operations per second, over all threads
+// - ops/s/thread : # -of operations per second, per thread
+// - efficiency   : ops/s/thread, relative to ops/s achieved by a single thread, when that benchmark was run earlier, in
+//                  same process. It's 1 for perfect scaling, dropping as threads start competing for shared caches,
+//                  memory bandwidth or execution units of a core ( under SMT ).
+//
+// `baseline` remembers ops/s of the single-threaded run, of same benchmark.
+template<typename fn_t>
+static inline void
+measure(benchmark::State& state, const bool pin, std::atomic<double>& baseline, fn_t&& fn)
+{
+  const pin_guard_t guard(pin, static_cast<size_t>(state.thread_index()));
+  if (pin && !guard.is_pinned()) {
+    state.SkipWithError("Failed to pin benchmarking thread to a CPU !");
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (auto _ : state) {
+    fn();
+    benchmark::ClobberMemory();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  const double secs = std::chrono::duration<double>(end - start).count();
+  const double rate = static_cast<double>(state.iterations()) / secs;
+
+  if (state.threads() == 1) {
+    baseline.store(rate);
+  }
+
+  const auto iters = static_cast<double>(state.iterations());
+  state.counters["ops/s"] = benchmark::Counter(iters, benchmark::Counter::kIsRate);
+  state.counters["ops/s/thread"] = benchmark::Counter(iters, benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads);
+
+  const double single = baseline.load();
+  if (single > 0.) {
+    state.counters["efficiency"] = benchmark::Counter(rate / single, benchmark::Counter::kAvgThreads);
+  }
+}
+
+// Benchmark SPHINCS+ signing, on many threads, each signing using its own keypair, optionally pinned to a CPU.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool pin>
+static inline void
+sign(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+
+  measure(state, pin, baseline, [&]() {
+    sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+    benchmark::DoNotOptimize(_sig);
+  });
+}
+
+// Benchmark SPHINCS+ signature verification, on many threads, each verifying a signature under its own public key,
+// optionally pinned to a CPU.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool pin>
+static inline void
+verify(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t mlen = state.range();
+
+  static std::atomic<double> baseline{ 0. };
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+
+  bool flag = true;
+  measure(state, pin, baseline, [&]() {
+    flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig, pkey);
+    benchmark::DoNotOptimize(flag);
+  });
+
+  assert(flag);
+}
+
+// Registers throughput benchmarks of signing and verification, for given SPHINCS+ parameter set, under name prefix
+// `name`, with # -of threads doubling from 1 to # -of available cores. Benchmarks suffixed with `_pinned` pin i-th
+// thread to i-th available CPU, so that threads don't migrate between cores. Run them, say, using
+// `make throughput`, which doesn't interleave benchmarks, so that single-threaded baseline is known to the rest.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+register_all(const std::string& name)
+{
+  const int max_threads = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+  const auto add = [&](const std::string& routine, auto fn) {
+    return benchmark::RegisterBenchmark((name + "/" + routine).c_str(), fn)
+      ->Arg(32)
+      ->ArgName("mlen")
+      ->ThreadRange(1, max_threads)
+      ->UseRealTime()
+      ->ComputeStatistics("min", compute_min)
+      ->ComputeStatistics("max", compute_max);
+  };
+
+  add("sign_throughput", sign<n, h, d, a, k, w, v, false>);
+  add("sign_throughput_pinned", sign<n, h, d, a, k, w, v, true>);
+  add("verify_throughput", verify<n, h, d, a, k, w, v, false>);
+  add("verify_throughput_pinned", verify<n, h, d, a, k, w, v, true>);
+
+  return true;
+}
+
+}
@@ -0,0 +1,35 @@
+#include "bench_helper.hpp"
+#include "bench_verity.hpp"
+#include <thread>
+
+// Object length ( = 64 MB ), to be split into chunks
+constexpr int64_t OBJECT_LEN = 1l << 26;
+
+// Registers Merkle Tree building benchmarks for a few chunk lengths ( 4 KB to 1 MB ), with # -of threads doubling from
+// 1 to # -of available cores, so that achieved bytes/s can be compared against core count. Also registers chunk
+// verification benchmarks, against an already authenticated object header.
+static const auto registered = []() {
+  const int64_t max_threads = std::max<int64_t>(1, static_cast<int64_t>(std::thread::hardware_concurrency()));
+
+  std::vector<int64_t> threads;
+  for (int64_t t = 1; t < max_threads; t <<= 1) {
+    threads.push_back(t);
+  }
+  threads.push_back(max_threads);
+
+  benchmark::RegisterBenchmark("sphincs+-128f-simple/verity_build_tree", bench_sphincs_plus_verity::build_tree<16>)
+    ->ArgsProduct({ { OBJECT_LEN }, { 1l << 12, 1l << 16, 1l << 20 }, threads })
+    ->ArgNames({ "object_len", "chunk_len", "threads" })
+    ->UseRealTime()
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  benchmark::RegisterBenchmark("sphincs+-128f-simple/verity_verify_chunk",
+                               bench_sphincs_plus_verity::verify_chunk<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>)
+    ->ArgsProduct({ { OBJECT_LEN }, { 1l << 12, 1l << 16, 1l << 20 } })
+    ->ArgNames({ "object_len", "chunk_len" })
+    ->ComputeStatistics("min", compute_min)
+    ->ComputeStatistics("max", compute_max);
+
+  return true;
+}();
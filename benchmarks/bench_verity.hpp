@@ -0,0 +1,154 @@
+#pragma once
+#include "prng.hpp"
+#include "verity.hpp"
+#include "x86_64_cpu_ticks.hpp"
+#include <benchmark/benchmark.h>
+
+// Benchmark SPHINCS+ Chunk-level Signed Content
+namespace bench_sphincs_plus_verity {
+
+// Benchmark building Merkle Tree over chunks of an object of fixed length, while varying chunk length and number of
+// threads used for building the tree.
+//
+// Arguments are expected in order ( object length in bytes, chunk length in bytes, # -of threads ).
+template<size_t n>
+static inline void
+build_tree(benchmark::State& state)
+{
+  const size_t object_len = static_cast<size_t>(state.range(0));
+  const size_t chunk_len = static_cast<size_t>(state.range(1));
+  const size_t thread_cnt = static_cast<size_t>(state.range(2));
+
+  std::vector<uint8_t> object(object_len, 0);
+  std::array<uint8_t, sphincs_plus_verity::get_header_len<n>()> header{};
+
+  auto _object = std::span(object);
+
+  prng::prng_t prng;
+  prng.read(_object);
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    sphincs_plus_verity::tree_t<n> tree(_object, chunk_len, thread_cnt);
+    tree.get_header(header);
+
+    benchmark::DoNotOptimize(_object);
+    benchmark::DoNotOptimize(header);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(object_len) * state.iterations());
+  state.counters["threads"] = static_cast<double>(thread_cnt);
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+// Benchmark verification of a chunk of an object, whose header is already authenticated, i.e. cost of hashing the
+// chunk and recomputing root of Merkle Tree.
+//
+// Arguments are expected in order ( object length in bytes, chunk length in bytes ).
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+verify_chunk(benchmark::State& state)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  const size_t object_len = static_cast<size_t>(state.range(0));
+  const size_t chunk_len = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> object(object_len, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+  std::array<uint8_t, sphincs_plus_verity::get_header_len<n>()> header{};
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _object = std::span(object);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_object);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+
+  sphincs_plus_verity::tree_t<n> tree(_object, chunk_len);
+  tree.get_header(header);
+  sphincs_plus_verity::sign<n, h, d, a, k, w, v>(header, _skey, {}, _sig);
+
+  const size_t chunk_cnt = tree.get_chunk_cnt();
+  std::vector<uint8_t> proofs(chunk_cnt * tree.get_proof_len(), 0);
+  auto _proofs = std::span(proofs);
+
+  for (size_t i = 0; i < chunk_cnt; i++) {
+    tree.get_proof(i, _proofs.subspan(i * tree.get_proof_len(), tree.get_proof_len()));
+  }
+
+  sphincs_plus_verity::verifier_t<n, h, d, a, k, w, v> verifier(_pkey);
+
+  // Authenticate object header, so that SPHINCS+ signature verification is kept out of the measured loop
+  bool flg = verifier.verify_chunk(header, _sig, 0, _object.first(std::min(chunk_len, object_len)), _proofs.first(tree.get_proof_len()));
+  size_t idx = 0;
+
+#ifdef __x86_64__
+  uint64_t total_ticks = 0ul;
+#endif
+
+  for (auto _ : state) {
+    const size_t off = idx * chunk_len;
+    auto chunk = _object.subspan(off, std::min(chunk_len, object_len - off));
+    auto proof = _proofs.subspan(idx * tree.get_proof_len(), tree.get_proof_len());
+
+#ifdef __x86_64__
+    const uint64_t start = cpu_ticks();
+#endif
+
+    flg &= verifier.verify_chunk(header, _sig, idx, chunk, proof);
+
+    benchmark::DoNotOptimize(flg);
+    benchmark::ClobberMemory();
+
+#ifdef __x86_64__
+    const uint64_t end = cpu_ticks();
+    total_ticks += (end - start);
+#endif
+
+    idx = (idx + 1) % chunk_cnt;
+  }
+
+  assert(flg);
+  state.SetBytesProcessed(static_cast<int64_t>(chunk_len) * state.iterations());
+
+#ifdef __x86_64__
+  total_ticks /= static_cast<uint64_t>(state.iterations());
+  state.counters["rdtsc"] = static_cast<double>(total_ticks);
+#endif
+}
+
+}
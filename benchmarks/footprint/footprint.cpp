@@ -0,0 +1,262 @@
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <ucontext.h>
+#include <vector>
+
+// Reports peak stack depth and heap usage of SPHINCS+ key generation, signing and verification, for all 12 parameter
+// sets, with and without caller-supplied workspace, so that stacks of fibers/ threads calling into the library can be
+// sized, and footprint regressions get caught.
+//
+// Each operation is run on its own stack ( a `ucontext_t` fiber ), which is painted with a known byte pattern before,
+// and scanned for the deepest overwritten byte after. Heap usage is tracked by replacing global allocation functions.
+//
+// Usage: ./build/footprint.out [--max-stack=<bytes>] [--max-heap=<bytes>]
+//
+// With limits given, exits with non-zero status, when any operation exceeds them.
+
+// Size of stack each operation is run on, far more than any of them needs
+constexpr size_t STACK_SIZE = 8ul << 20;
+
+// Byte pattern stack is painted with
+constexpr uint8_t PAINT = 0xa5;
+
+// Heap usage of calling thread, while tracking is enabled
+static thread_local bool track_heap = false;
+static thread_local size_t heap_cur = 0;
+static thread_local size_t heap_peak = 0;
+static thread_local size_t heap_allocs = 0;
+
+// Each allocation is prefixed with its size, so that it can be accounted for, when freed
+constexpr size_t HEADER = alignof(std::max_align_t);
+
+void*
+operator new(size_t size)
+{
+  auto ptr = static_cast<uint8_t*>(std::malloc(size + HEADER));
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  std::memcpy(ptr, &size, sizeof(size));
+  if (track_heap) {
+    heap_cur += size;
+    heap_peak = std::max(heap_peak, heap_cur);
+    heap_allocs++;
+  }
+
+  return ptr + HEADER;
+}
+
+void*
+operator new[](size_t size)
+{
+  return ::operator new(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto base = static_cast<uint8_t*>(ptr) - HEADER;
+  if (track_heap) {
+    size_t size = 0;
+    std::memcpy(&size, base, sizeof(size));
+    heap_cur -= std::min(heap_cur, size);
+  }
+
+  std::free(base);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+// Peak stack depth and heap usage of an operation, in bytes, along with # -of heap allocations
+struct footprint_t
+{
+  size_t stack = 0;
+  size_t heap = 0;
+  size_t allocs = 0;
+};
+
+// Operation run on fiber stack, which can't be passed to `makecontext` directly
+static std::function<void()>* job = nullptr;
+
+static ucontext_t caller_ctx;
+static ucontext_t fiber_ctx;
+
+static void
+trampoline()
+{
+  (*job)();
+}
+
+// Runs `fn` on a freshly painted stack, returning how deep it got, in bytes, along with heap usage of it.
+static inline footprint_t
+measure(std::function<void()> fn)
+{
+  static std::vector<uint8_t> stack(STACK_SIZE, 0);
+  std::fill(stack.begin(), stack.end(), PAINT);
+
+  job = &fn;
+
+  getcontext(&fiber_ctx);
+  fiber_ctx.uc_stack.ss_sp = stack.data();
+  fiber_ctx.uc_stack.ss_size = stack.size();
+  fiber_ctx.uc_link = &caller_ctx;
+  makecontext(&fiber_ctx, trampoline, 0);
+
+  heap_cur = heap_peak = heap_allocs = 0;
+  track_heap = true;
+
+  swapcontext(&caller_ctx, &fiber_ctx);
+
+  track_heap = false;
+  job = nullptr;
+
+  // Stack grows downwards, so deepest overwritten byte is the first non-painted one, from lower end
+  const auto it = std::find_if(stack.begin(), stack.end(), [](const uint8_t b) { return b != PAINT; });
+  const auto untouched = static_cast<size_t>(std::distance(stack.begin(), it));
+
+  return { STACK_SIZE - untouched, heap_peak, heap_allocs };
+}
+
+// Stack used by fiber trampoline itself, to be subtracted from each measurement
+static inline size_t
+overhead()
+{
+  static const size_t bytes = measure([]() {}).stack;
+  return bytes;
+}
+
+// Limits on peak stack depth and heap usage, in bytes, unlimited unless given
+static size_t max_stack = SIZE_MAX;
+static size_t max_heap = SIZE_MAX;
+static bool exceeded = false;
+
+static inline void
+report(const std::string& name, const std::string& op, const bool with_ws, const footprint_t& fp)
+{
+  const size_t stack = fp.stack - std::min(fp.stack, overhead());
+  const bool over = (stack > max_stack) || (fp.heap > max_heap);
+  exceeded |= over;
+
+  std::printf("%-22s | %-6s | %-9s | %12zu | %12zu | %6zu%s\n", name.c_str(), op.c_str(), with_ws ? "caller" : "stack", stack, fp.heap, fp.allocs, over ? " <- exceeds limit" : "");
+}
+
+// Measures footprint of key generation, signing and verification of a 32 -bytes message, for given SPHINCS+ parameter
+// set, both with workspace living on stack and supplied by caller.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+footprint(const std::string& name)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  constexpr size_t mlen = 32;
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+  auto ws = std::make_unique<sphincs_plus_xmss::workspace_t<n>>();
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msg = std::span<uint8_t>(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msg);
+
+  bool flag = true;
+
+  for (const bool with_ws : { false, true }) {
+    auto _ws = with_ws ? ws.get() : nullptr;
+
+    const auto kg = measure([&]() { sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey, _ws); });
+    const auto sg = measure([&]() { sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig, _ws); });
+    const auto vf = measure([&]() { flag &= sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey); });
+
+    report(name, "keygen", with_ws, kg);
+    report(name, "sign", with_ws, sg);
+    report(name, "verify", with_ws, vf);
+  }
+
+  if (!flag) {
+    std::fprintf(stderr, "Signature verification failed for %s\n", name.c_str());
+    exceeded = true;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+
+    if (arg.starts_with("--max-stack=")) {
+      max_stack = std::strtoull(arg.c_str() + std::strlen("--max-stack="), nullptr, 10);
+    } else if (arg.starts_with("--max-heap=")) {
+      max_heap = std::strtoull(arg.c_str() + std::strlen("--max-heap="), nullptr, 10);
+    } else {
+      std::fprintf(stderr, "Usage: %s [--max-stack=<bytes>] [--max-heap=<bytes>]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  using sphincs_plus_hashing::variant;
+
+  std::printf("%-22s | %-6s | %-9s | %12s | %12s | %6s\n", "parameter set", "op", "workspace", "stack (B)", "heap (B)", "allocs");
+  std::printf("%s\n", std::string(84, '-').c_str());
+
+  footprint<16, 63, 7, 12, 14, 16, variant::robust>("sphincs+-128s-robust");
+  footprint<16, 63, 7, 12, 14, 16, variant::simple>("sphincs+-128s-simple");
+  footprint<16, 66, 22, 6, 33, 16, variant::robust>("sphincs+-128f-robust");
+  footprint<16, 66, 22, 6, 33, 16, variant::simple>("sphincs+-128f-simple");
+  footprint<24, 63, 7, 14, 17, 16, variant::robust>("sphincs+-192s-robust");
+  footprint<24, 63, 7, 14, 17, 16, variant::simple>("sphincs+-192s-simple");
+  footprint<24, 66, 22, 8, 33, 16, variant::robust>("sphincs+-192f-robust");
+  footprint<24, 66, 22, 8, 33, 16, variant::simple>("sphincs+-192f-simple");
+  footprint<32, 64, 8, 14, 22, 16, variant::robust>("sphincs+-256s-robust");
+  footprint<32, 64, 8, 14, 22, 16, variant::simple>("sphincs+-256s-simple");
+  footprint<32, 68, 17, 9, 35, 16, variant::robust>("sphincs+-256f-robust");
+  footprint<32, 68, 17, 9, 35, 16, variant::simple>("sphincs+-256f-simple");
+
+  return exceeded ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+
+#if defined __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Minimal wrapper over Linux `perf_event_open(2)`, for counting hardware events of benchmarking thread, without
+// requiring google-benchmark to be built with libPFM.
+namespace bench_perf_events {
+
+// Hardware event, counted in user-space, along with name it's reported under, per operation.
+struct event_t
+{
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+#if defined __linux__
+
+// Encodes a hardware cache event, see `perf_event_open(2)`
+static inline constexpr uint64_t
+cache_event(const uint64_t cache, const uint64_t op, const uint64_t result)
+{
+  return cache | (op << 8) | (result << 16);
+}
+
+constexpr std::array<event_t, 5> EVENTS = { {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { "L1D_misses", PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+  { "LLC_misses", PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+} };
+
+#else
+
+constexpr std::array<event_t, 0> EVENTS{};
+
+#endif
+
+// Counts `EVENTS` on calling thread, between `start` and `stop`. Each event is opened on its own, so that unavailable
+// ones ( say, LLC misses inside a VM, or all of them, when `perf_event_paranoid` forbids it or on non-Linux platforms )
+// are simply skipped, instead of failing the benchmark. When kernel multiplexes counters, counts are scaled up by
+// enabled/ running time.
+struct perf_events_t
+{
+private:
+  std::array<int, EVENTS.size()> fds{};
+  std::array<double, EVENTS.size()> counts{};
+  std::array<bool, EVENTS.size()> valid{};
+
+public:
+  inline perf_events_t()
+  {
+    fds.fill(-1);
+
+#if defined __linux__
+    for (size_t i = 0; i < EVENTS.size(); i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+
+      attr.size = sizeof(attr);
+      attr.type = EVENTS[i].type;
+      attr.config = EVENTS[i].config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+  }
+
+  inline ~perf_events_t()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  perf_events_t(const perf_events_t&) = delete;
+  perf_events_t& operator=(const perf_events_t&) = delete;
+
+  // Whether any of the events could be opened.
+  inline bool available() const
+  {
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Resets and starts counting.
+  inline void start()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // Stops counting and reads counts, since `start` was called.
+  inline void stop()
+  {
+#if defined __linux__
+    for (const int fd : fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+
+    for (size_t i = 0; i < EVENTS.size(); i++) {
+      valid[i] = false;
+      if (fds[i] < 0) {
+        continue;
+      }
+
+      // value, time enabled, time running
+      std::array<uint64_t, 3> buf{};
+      if (read(fds[i], buf.data(), sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[2] == 0) {
+        continue;
+      }
+
+      counts[i] = static_cast<double>(buf[0]) * (static_cast<double>(buf[1]) / static_cast<double>(buf[2]));
+      valid[i] = true;
+    }
+#endif
+  }
+
+  // Reports each successfully counted event, per iteration, as `<event>/op`, along with instructions per cycle, as
+  // `IPC`, when both are available. Reports nothing otherwise.
+  inline void report(benchmark::State& state) const
+  {
+    const auto iters = static_cast<double>(state.iterations());
+
+    for (size_t i = 0; i < EVENTS.size(); i++) {
+      if (valid[i]) {
+        state.counters[std::string(EVENTS[i].name) + "/op"] = counts[i] / iters;
+      }
+    }
+
+    if constexpr (EVENTS.size() >= 2) {
+      if (valid[0] && valid[1] && counts[0] > 0.) {
+        state.counters["IPC"] = counts[1] / counts[0];
+      }
+    }
+  }
+};
+
+}
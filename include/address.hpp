@@ -1,5 +1,8 @@
 #pragma once
-#include "utils.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 // Hash function address scheme for SPHINCS+
 namespace sphincs_plus_adrs {
@@ -30,46 +33,85 @@ static constexpr size_t WORD5_BEGIN = WORD4_BEGIN + WORD_BYTE_WIDTH;
 static constexpr size_t WORD6_BEGIN = WORD5_BEGIN + WORD_BYTE_WIDTH;
 static constexpr size_t WORD7_BEGIN = WORD6_BEGIN + WORD_BYTE_WIDTH;
 static constexpr size_t ADRS_BYTE_WIDTH = WORD7_BEGIN + WORD_BYTE_WIDTH;
+static constexpr size_t ADRS_WORD_COUNT = ADRS_BYTE_WIDTH / WORD_BYTE_WIDTH;
 
 // Common structure of SPHINCS+ ADRS ( 32 -bytes wide ), with each word being 4 -bytes wide.
+//
+// Words are kept in native byte order, so that setters and getters, which are
+// called in innermost chain and tree loops, are plain loads and stores. ADRS is
+// serialized to its 32 -bytes big-endian form only when it's being hashed, see
+// `to_bytes`, which writes it straight into input of the hash function.
 struct adrs_t
 {
-  std::array<uint8_t, ADRS_BYTE_WIDTH> data{};
+private:
+  // Writes a 32 -bit word to 4 -bytes, in big-endian byte order, which compilers
+  // lower to a byte swap and a store.
+  static inline void store_be_word(const uint32_t word, std::span<uint8_t, WORD_BYTE_WIDTH> bytes)
+  {
+    bytes[0] = static_cast<uint8_t>(word >> 24);
+    bytes[1] = static_cast<uint8_t>(word >> 16);
+    bytes[2] = static_cast<uint8_t>(word >> 8);
+    bytes[3] = static_cast<uint8_t>(word >> 0);
+  }
+
+public:
+  std::array<uint32_t, ADRS_WORD_COUNT> words{};
 
   adrs_t() = default;
-  adrs_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
+  adrs_t(const adrs_t& adrs) = default;
+  adrs_t& operator=(const adrs_t& adrs) = default;
 
-  // Returns 1 -word wide layer address
-  inline uint32_t get_layer_address() const
+  // Parses 32 -bytes big-endian serialized ADRS
+  explicit adrs_t(std::span<const uint8_t, ADRS_BYTE_WIDTH> bytes)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD0_BEGIN, WORD_BYTE_WIDTH>());
+    for (size_t i = 0; i < ADRS_WORD_COUNT; i++) {
+      const size_t off = i * WORD_BYTE_WIDTH;
+
+      words[i] = (static_cast<uint32_t>(bytes[off + 0]) << 24) | (static_cast<uint32_t>(bytes[off + 1]) << 16) |
+                 (static_cast<uint32_t>(bytes[off + 2]) << 8) | (static_cast<uint32_t>(bytes[off + 3]) << 0);
+    }
   }
 
-  // Only sets 1 -word wide layer address
-  inline void set_layer_address(const uint32_t address)
+  // Serializes ADRS to 32 -bytes, with each word in big-endian byte order
+  inline void to_bytes(std::span<uint8_t, ADRS_BYTE_WIDTH> bytes) const
   {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD0_BEGIN, WORD_BYTE_WIDTH>());
+    for (size_t i = 0; i < ADRS_WORD_COUNT; i++) {
+      store_be_word(words[i], std::span<uint8_t, WORD_BYTE_WIDTH>(bytes.subspan(i * WORD_BYTE_WIDTH, WORD_BYTE_WIDTH)));
+    }
   }
 
-  // Returns 3 -word wide tree address
-  inline std::array<uint32_t, 3> get_tree_address() const
+  // Serializes only i -th word of ADRS, into its position in already serialized
+  // 32 -bytes ADRS, useful when only one word changes between two hash calls.
+  template<size_t i>
+  inline void word_to_bytes(std::span<uint8_t, ADRS_BYTE_WIDTH> bytes) const
+    requires(i < ADRS_WORD_COUNT)
+  {
+    store_be_word(words[i], bytes.template subspan<i * WORD_BYTE_WIDTH, WORD_BYTE_WIDTH>());
+  }
+
+  // Returns 32 -bytes serialized ADRS
+  inline std::array<uint8_t, ADRS_BYTE_WIDTH> to_bytes() const
   {
-    auto _data = std::span(data);
-    return { sphincs_plus_utils::from_be_bytes(_data.subspan<WORD1_BEGIN, WORD_BYTE_WIDTH>()),
-             sphincs_plus_utils::from_be_bytes(_data.subspan<WORD2_BEGIN, WORD_BYTE_WIDTH>()),
-             sphincs_plus_utils::from_be_bytes(_data.subspan<WORD3_BEGIN, WORD_BYTE_WIDTH>()) };
+    std::array<uint8_t, ADRS_BYTE_WIDTH> bytes{};
+    to_bytes(bytes);
+    return bytes;
   }
 
+  // Returns 1 -word wide layer address
+  inline uint32_t get_layer_address() const { return words[0]; }
+
+  // Only sets 1 -word wide layer address
+  inline void set_layer_address(const uint32_t address) { words[0] = address; }
+
+  // Returns 3 -word wide tree address
+  inline std::array<uint32_t, 3> get_tree_address() const { return { words[1], words[2], words[3] }; }
+
   // Only sets 3 -word wide tree address
   inline void set_tree_address(const std::array<uint32_t, 3> address)
   {
-    auto _data = std::span(data);
-
-    sphincs_plus_utils::to_be_bytes(address[0], _data.subspan<WORD1_BEGIN, WORD_BYTE_WIDTH>());
-    sphincs_plus_utils::to_be_bytes(address[1], _data.subspan<WORD2_BEGIN, WORD_BYTE_WIDTH>());
-    sphincs_plus_utils::to_be_bytes(address[2], _data.subspan<WORD3_BEGIN, WORD_BYTE_WIDTH>());
+    words[1] = address[0];
+    words[2] = address[1];
+    words[3] = address[2];
   }
 
   // Only sets 3 -word wide tree address with a 64 -bit address i.e. higher
@@ -83,20 +125,15 @@ struct adrs_t
   }
 
   // Returns 1 -word wide address type
-  inline type_t get_type() const
-  {
-    auto _data = std::span(data);
-    return static_cast<type_t>(sphincs_plus_utils::from_be_bytes(_data.subspan<WORD4_BEGIN, WORD_BYTE_WIDTH>()));
-  }
+  inline type_t get_type() const { return static_cast<type_t>(words[4]); }
 
   // Sets 1 -word wide address type, along with that zeros subsequent 3 -words.
   inline void set_type(const type_t type)
   {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(type), _data.subspan<WORD4_BEGIN, WORD_BYTE_WIDTH>());
-
-    auto __data = _data.subspan<WORD5_BEGIN, ADRS_BYTE_WIDTH - WORD5_BEGIN>();
-    std::fill(__data.begin(), __data.end(), 0x00);
+    words[4] = static_cast<uint32_t>(type);
+    words[5] = 0u;
+    words[6] = 0u;
+    words[7] = 0u;
   }
 };
 
@@ -104,77 +141,53 @@ struct adrs_t
 struct wots_hash_t : adrs_t
 {
   wots_hash_t() = default;
-  wots_hash_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  wots_hash_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Set 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Returns 1 -word wide chain address
-  inline uint32_t get_chain_address() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_chain_address() const { return words[6]; }
 
   // Set 1 -word wide chain address
-  inline void set_chain_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_chain_address(const uint32_t address) { words[6] = address; }
 
   // Returns 1 -word wide hash address
-  inline uint32_t get_hash_address() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_hash_address() const { return words[7]; }
 
   // Set 1 -word wide hash address
-  inline void set_hash_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_hash_address(const uint32_t address) { words[7] = address; }
+
+  // Moves to next step of same chain, incrementing 1 -word wide hash address
+  inline void inc_hash_address() { words[7]++; }
 };
 
 // Structure of WOTS+ Public Key Compression Address
 struct wots_pk_t : adrs_t
 {
   wots_pk_t() = default;
-  wots_pk_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  wots_pk_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Set 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Zeros last two words of ADRS structure
   inline void set_padding()
   {
-    auto _data = std::span(data);
-    auto __data = _data.subspan<WORD6_BEGIN, ADRS_BYTE_WIDTH - WORD6_BEGIN>();
-    std::fill(__data.begin(), __data.end(), 0x00);
+    words[6] = 0u;
+    words[7] = 0u;
   }
 };
 
@@ -182,120 +195,81 @@ struct wots_pk_t : adrs_t
 struct tree_t : adrs_t
 {
   tree_t() = default;
-  tree_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Zeros 1 -word wide padding
-  inline void set_padding()
+  tree_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    auto __data = _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>();
-    std::fill(__data.begin(), __data.end(), 0x00);
   }
 
+  // Zeros 1 -word wide padding
+  inline void set_padding() { words[5] = 0u; }
+
   // Returns 1 -word wide tree height
-  inline uint32_t get_tree_height() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_tree_height() const { return words[6]; }
 
   // Sets 1 -word wide tree height
-  inline void set_tree_height(const uint32_t height)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(height, _data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_tree_height(const uint32_t height) { words[6] = height; }
 
   // Returns 1 -word wide tree index
-  inline uint32_t get_tree_index() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_tree_index() const { return words[7]; }
 
   // Sets 1 -word wide tree index
-  inline void set_tree_index(const uint32_t idx)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(idx, _data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_tree_index(const uint32_t idx) { words[7] = idx; }
+
+  // Moves to next node of same tree level, incrementing 1 -word wide tree index
+  inline void inc_tree_index() { words[7]++; }
 };
 
 // Structure of FORS Tree Address
 struct fors_tree_t : adrs_t
 {
   fors_tree_t() = default;
-  fors_tree_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  fors_tree_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Sets 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Returns 1 -word wide tree height
-  inline uint32_t get_tree_height() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_tree_height() const { return words[6]; }
 
   // Sets 1 -word wide tree height
-  inline void set_tree_height(const uint32_t height)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(height, _data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_tree_height(const uint32_t height) { words[6] = height; }
 
   // Returns 1 -word wide tree index
-  inline uint32_t get_tree_index() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_tree_index() const { return words[7]; }
 
   // Sets 1 -word wide tree index
-  inline void set_tree_index(const uint32_t idx)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(idx, _data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_tree_index(const uint32_t idx) { words[7] = idx; }
+
+  // Moves to next node of same tree level, incrementing 1 -word wide tree index
+  inline void inc_tree_index() { words[7]++; }
 };
 
 // Structure of FORS Tree Root Compression Address
 struct fors_roots_t : adrs_t
 {
   fors_roots_t() = default;
-  fors_roots_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  fors_roots_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Sets 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Zeros last two words of ADRS structure
   inline void set_padding()
   {
-    auto _data = std::span(data);
-    auto __data = _data.subspan<WORD6_BEGIN, ADRS_BYTE_WIDTH - WORD6_BEGIN>();
-    std::fill(__data.begin(), __data.end(), 0x00);
+    words[6] = 0u;
+    words[7] = 0u;
   }
 };
 
@@ -303,92 +277,56 @@ struct fors_roots_t : adrs_t
 struct wots_prf_t : adrs_t
 {
   wots_prf_t() = default;
-  wots_prf_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  wots_prf_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Set 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Returns 1 -word wide chain address
-  inline uint32_t get_chain_address() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_chain_address() const { return words[6]; }
 
   // Set 1 -word wide chain address
-  inline void set_chain_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_chain_address(const uint32_t address) { words[6] = address; }
 
   // Returns 1 -word wide hash address, which is always set to 0
   inline constexpr uint32_t get_hash_address() const { return 0u; }
 
   // Zeros 1 -word wide hash address
-  inline void set_hash_address()
-  {
-    auto _data = std::span(data);
-    auto __data = _data.subspan<WORD7_BEGIN, ADRS_BYTE_WIDTH - WORD7_BEGIN>();
-    std::fill(__data.begin(), __data.end(), 0x00);
-  }
+  inline void set_hash_address() { words[7] = 0u; }
 };
 
 // Structure of FORS Key Generation Address
 struct fors_prf_t : adrs_t
 {
   fors_prf_t() = default;
-  fors_prf_t(const adrs_t& adrs) { std::copy(adrs.data.begin(), adrs.data.end(), data.begin()); }
-
-  // Returns 1 -word wide keypair address
-  inline uint32_t get_keypair_address() const
+  fors_prf_t(const adrs_t& adrs)
+    : adrs_t(adrs)
   {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
   }
 
+  // Returns 1 -word wide keypair address
+  inline uint32_t get_keypair_address() const { return words[5]; }
+
   // Sets 1 -word wide key pair address
-  inline void set_keypair_address(const uint32_t address)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(address, _data.subspan<WORD5_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_keypair_address(const uint32_t address) { words[5] = address; }
 
   // Returns 1 -word wide tree height
   inline constexpr uint32_t get_tree_height() const { return 0u; }
 
   // Zeros 1 -word wide tree height
-  inline void set_tree_height()
-  {
-    auto _data = std::span(data);
-    auto __data = _data.subspan<WORD6_BEGIN, WORD_BYTE_WIDTH>();
-    std::fill(__data.begin(), __data.end(), 0x00);
-  }
+  inline void set_tree_height() { words[6] = 0u; }
 
   // Returns 1 -word wide tree index
-  inline uint32_t get_tree_index() const
-  {
-    auto _data = std::span(data);
-    return sphincs_plus_utils::from_be_bytes(_data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline uint32_t get_tree_index() const { return words[7]; }
 
   // Sets 1 -word wide tree index
-  inline void set_tree_index(const uint32_t idx)
-  {
-    auto _data = std::span(data);
-    sphincs_plus_utils::to_be_bytes(idx, _data.subspan<WORD7_BEGIN, WORD_BYTE_WIDTH>());
-  }
+  inline void set_tree_index(const uint32_t idx) { words[7] = idx; }
 };
 
 }
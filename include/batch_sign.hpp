@@ -0,0 +1,187 @@
+#pragma once
+#include "merkle.hpp"
+#include "sphincs+.hpp"
+
+// Batch Signing: a single SPHINCS+ signature, over root of a Merkle Tree built on a batch of messages, authenticates
+// each message of the batch, along with its inclusion proof
+namespace sphincs_plus_batch {
+
+// Domain separation prefix, for message which gets signed using SPHINCS+ i.e. the encoded Merkle Tree root, so that a
+// batch signature can't be confused with a chunk-level signature ( see include/verity.hpp, prefix 0x03 ), under same
+// key. Note, regular messages aren't prefixed by `sphincs_plus::sign`, so a regular SPHINCS+ signature over
+// 0x02 || ... is indistinguishable from a batch signature. Don't use a key for both, unless regular messages can never
+// start with this prefix.
+constexpr uint8_t ROOT_PREFIX = 0x02;
+
+// Maximum height of Merkle Tree, supported by batch signing i.e. a batch can have at max 2^32 messages.
+constexpr uint32_t MAX_DEPTH = 32;
+
+using sphincs_plus_merkle::get_node_len;
+
+// Compile-time compute byte length of encoded Merkle Tree root, which is signed using SPHINCS+ s.t.
+// encoded root = ROOT_PREFIX (1 -byte) || tree height (1 -byte) || root (2*n -bytes)
+template<size_t n>
+static inline constexpr size_t
+get_root_msg_len()
+{
+  return 1 + 1 + get_node_len<n>();
+}
+
+// Computes byte length of inclusion proof of each message, in a batch of `msg_cnt` -many messages s.t.
+// inclusion proof = leaf index (4 -bytes, big-endian) || tree height (1 -byte) || authentication path (height * 2*n -bytes)
+template<size_t n>
+static inline constexpr size_t
+get_proof_len(const size_t msg_cnt)
+{
+  return 4 + 1 + static_cast<size_t>(sphincs_plus_merkle::compute_depth(msg_cnt)) * get_node_len<n>();
+}
+
+// Given 2*n -bytes Merkle Tree root and height of the tree, this routine encodes them as message, to be signed using
+// SPHINCS+.
+template<size_t n>
+static inline void
+encode_root(std::span<const uint8_t, get_node_len<n>()> root, const uint32_t depth, std::span<uint8_t, get_root_msg_len<n>()> root_msg)
+{
+  root_msg[0] = ROOT_PREFIX;
+  root_msg[1] = static_cast<uint8_t>(depth);
+  std::copy(root.begin(), root.end(), root_msg.template subspan<2, root.size()>().begin());
+}
+
+// Given a message and its inclusion proof, this routine recomputes encoded Merkle Tree root ( see `encode_root` ),
+// returning truth value only if the proof is well-formed.
+template<size_t n>
+static inline bool
+root_from_proof(std::span<const uint8_t> msg, std::span<const uint8_t> proof, std::span<uint8_t, get_root_msg_len<n>()> root_msg)
+{
+  constexpr size_t m = get_node_len<n>();
+
+  if (proof.size() < 5) {
+    return false;
+  }
+
+  const uint32_t idx = sphincs_plus_utils::from_be_bytes(proof.template subspan<0, 4>());
+  const uint32_t depth = proof[4];
+  if ((depth > MAX_DEPTH) || (proof.size() != (5 + depth * m)) || (static_cast<uint64_t>(idx) >> depth) != 0) {
+    return false;
+  }
+
+  std::array<uint8_t, m> leaf{};
+  std::array<uint8_t, m> root{};
+
+  sphincs_plus_merkle::hash_leaf<m>(msg, leaf);
+  sphincs_plus_merkle::root_from_path<m>(leaf, idx, proof.subspan(5), root);
+
+  encode_root<n>(root, depth, root_msg);
+  return true;
+}
+
+// Signs a batch of messages, using 4*n -bytes SPHINCS+ secret key, by building a SHAKE256 Merkle Tree ( leaves are
+// hashes of messages ) and signing encoded root of the tree, once. Batch signature is written to `sig`, which is shared
+// by all messages of the batch, while inclusion proof of i -th message is written to i -th `get_proof_len<n>(msgs.size())`
+// -bytes wide segment of `proofs`. A message is authenticated by (sig, proof) bundle.
+//
+// Randomized signing works same as `sphincs_plus::sign`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize = false>
+static inline void
+sign(std::span<const std::span<const uint8_t>> msgs,
+     std::span<const uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
+     std::span<const uint8_t, n * randomize> rand_bytes,
+     std::span<uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+     std::span<uint8_t> proofs)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  constexpr size_t m = get_node_len<n>();
+
+  const size_t msg_cnt = msgs.size();
+  const uint32_t depth = sphincs_plus_merkle::compute_depth(msg_cnt);
+  const size_t proof_len = get_proof_len<n>(msg_cnt);
+
+  assert((msg_cnt > 0) && (depth <= MAX_DEPTH));
+  assert(proofs.size() == msg_cnt * proof_len);
+
+  std::vector<uint8_t> nodes(sphincs_plus_merkle::compute_node_cnt(depth) * m, 0);
+  auto _nodes = std::span(nodes);
+
+  for (size_t i = 0; i < msg_cnt; i++) {
+    sphincs_plus_merkle::hash_leaf<m>(msgs[i], std::span<uint8_t, m>(_nodes.subspan(i * m, m)));
+  }
+
+  sphincs_plus_merkle::build_tree<m>(msg_cnt, depth, _nodes);
+
+  std::array<uint8_t, get_root_msg_len<n>()> root_msg{};
+  encode_root<n>(std::span<const uint8_t, m>(_nodes.last(m)), depth, root_msg);
+
+  sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(root_msg, skey, rand_bytes, sig);
+
+  for (size_t i = 0; i < msg_cnt; i++) {
+    auto proof = proofs.subspan(i * proof_len, proof_len);
+
+    sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(i), proof.template subspan<0, 4>());
+    proof[4] = static_cast<uint8_t>(depth);
+    sphincs_plus_merkle::auth_path<m>(_nodes, depth, i, proof.subspan(5));
+  }
+}
+
+// Verifies a message of a signed batch, using its (sig, proof) bundle and 2*n -bytes SPHINCS+ public key, returning
+// truth value in case of successful verification. This routine always verifies SPHINCS+ signature, see `verifier_t`
+// for verifying many messages of same batch, at the cost of a single SPHINCS+ signature verification.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+verify(std::span<const uint8_t> msg,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+       std::span<const uint8_t> proof,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  std::array<uint8_t, get_root_msg_len<n>()> root_msg{};
+  if (!root_from_proof<n>(msg, proof, root_msg)) {
+    return false;
+  }
+
+  return sphincs_plus::verify<n, h, d, a, k, w, v>(root_msg, sig, pkey);
+}
+
+// Batch signature verifier, bound to a SPHINCS+ public key, which remembers encoded Merkle Tree roots of last few
+// successfully verified batches. Once a batch signature is verified, all other messages of that batch are verified by
+// recomputing the root from message and its inclusion proof, without verifying SPHINCS+ signature again.
+//
+// Verifier is safe to be shared among threads. It keeps at max `capacity` -many roots, evicting the oldest one, when
+// full.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+struct verifier_t
+{
+private:
+  static constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  static constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  sphincs_plus_merkle::root_verifier_t<get_root_msg_len<n>(), n, h, d, a, k, w, v> roots;
+
+public:
+  // Constructs a batch signature verifier for given 2*n -bytes SPHINCS+ public key, remembering at max `capacity`
+  // (>0) -many authenticated batch roots.
+  inline explicit verifier_t(std::span<const uint8_t, pklen> pkey, const size_t capacity = 16)
+    : roots(pkey, capacity)
+  {
+  }
+
+  // Verifies a message of a signed batch, using its (sig, proof) bundle, returning truth value in case of successful
+  // verification. SPHINCS+ signature is verified only if root of the batch is not yet authenticated.
+  inline bool verify(std::span<const uint8_t> msg, std::span<const uint8_t, siglen> sig, std::span<const uint8_t> proof)
+  {
+    std::array<uint8_t, get_root_msg_len<n>()> root_msg{};
+    if (!root_from_proof<n>(msg, proof, root_msg)) {
+      return false;
+    }
+
+    return roots.verify(root_msg, sig);
+  }
+
+  // Returns # -of verifications which didn't require verifying SPHINCS+ signature.
+  inline uint64_t get_hits() const { return roots.get_hits(); }
+
+  // Returns # -of verifications which required verifying SPHINCS+ signature.
+  inline uint64_t get_misses() const { return roots.get_misses(); }
+};
+
+}
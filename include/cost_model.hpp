@@ -0,0 +1,307 @@
+#pragma once
+#include "counters.hpp"
+#include "hashing.hpp"
+#include "utils.hpp"
+#include "xmss.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time cost model of SPHINCS+-SHAKE, counting tweakable hash function, PRF and Keccak-f[1600] permutation
+// invocations, key generation, signing and verification require, for any parameter set. Counts are expressed as
+// `sphincs_plus_counters::counters_t`, so that they can be compared against runtime counters, see include/counters.hpp.
+namespace sphincs_plus_cost_model {
+
+using sphincs_plus_counters::counters_t;
+using sphincs_plus_counters::hash_t;
+
+// Returns counters of `cnt` -many invocations of hash function of given kind, each requiring `perms` -many
+// Keccak-f[1600] permutations.
+template<hash_t kind>
+static inline constexpr counters_t
+calls(const uint64_t cnt, const uint64_t perms)
+{
+  counters_t res{};
+  res.calls[static_cast<size_t>(kind)] = cnt;
+  res.permutations = cnt * perms;
+
+  return res;
+}
+
+// `cnt` -many T_l calls, counted as F when l = 1 and as H when l = 2, see `sphincs_plus_hashing::record_t_l`.
+template<size_t n, size_t l, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+t_l(const uint64_t cnt = 1)
+{
+  constexpr hash_t kind = (l == 1) ? hash_t::f : ((l == 2) ? hash_t::h : hash_t::t_l);
+  return calls<kind>(cnt, sphincs_plus_hashing::t_l_permutations<n, l, v>());
+}
+
+// `cnt` -many PRF calls, each of which fits in a single block of SHAKE256.
+static inline constexpr counters_t
+prf(const uint64_t cnt = 1)
+{
+  return calls<hash_t::prf>(cnt, 1);
+}
+
+// A PRF_msg call, on mlen -bytes message.
+template<size_t n>
+static inline constexpr counters_t
+prf_msg(const size_t mlen)
+{
+  return calls<hash_t::prf_msg>(1, sphincs_plus_counters::shake256_permutations(n + n + mlen, n));
+}
+
+// A H_msg call, on mlen -bytes message, producing m -bytes digest, see section 6.4 of SPHINCS+ specification
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k>
+static inline constexpr counters_t
+h_msg(const size_t mlen)
+{
+  constexpr size_t md_len = static_cast<size_t>((k * a + 7) / 8);
+  constexpr size_t itree_len = static_cast<size_t>((h - (h / d) + 7) / 8);
+  constexpr size_t ileaf_len = static_cast<size_t>(((h / d) + 7) / 8);
+  constexpr size_t m = md_len + itree_len + ileaf_len;
+
+  return calls<hash_t::h_msg>(1, sphincs_plus_counters::shake256_permutations(n + n + n + mlen, m));
+}
+
+// WOTS+ key generation, see `sphincs_plus_wots::pkgen`, walking each of len -many chains from start to end. Signing
+// along with key generation, see `sphincs_plus_wots::pkgen_and_sign`, costs exactly same.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+wots_pkgen()
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  return prf(len) + t_l<n, 1, v>(len * (w - 1)) + t_l<n, len, v>();
+}
+
+// WOTS+ public key computation from signature, see `sphincs_plus_wots::pk_from_sig`, when `steps` -many chain steps
+// are left to be walked, over all chains, which depends on message digits, see `wots_verify_steps`.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+wots_pk_from_sig(const uint64_t steps)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  return t_l<n, 1, v>(steps) + t_l<n, len, v>();
+}
+
+// Root of XMSS tree of height h, see `sphincs_plus_xmss::pkgen`, requiring 2^h WOTS+ key generations and 2^h - 1 H
+// calls. Signing along with computing root, see `sphincs_plus_xmss::sign_and_root`, costs exactly same.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+xmss_pkgen()
+{
+  constexpr uint64_t leaf_cnt = 1ul << h;
+  return wots_pkgen<n, w, v>() * leaf_cnt + t_l<n, 2, v>(leaf_cnt - 1);
+}
+
+// XMSS public key computation from signature, see `sphincs_plus_xmss::pk_from_sig`, when `steps` -many WOTS+ chain
+// steps are left to be walked.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+xmss_pk_from_sig(const uint64_t steps)
+{
+  return wots_pk_from_sig<n, w, v>(steps) + t_l<n, 2, v>(h);
+}
+
+// FORS signing, see `sphincs_plus_fors::sign`. For each of k trees, a secret key value is revealed and authentication
+// path node at height j is computed by treehash over 2^j leaves, so that 2^a PRF, 2^a - 1 F and 2^a - 1 - a H calls
+// are made per tree.
+template<size_t n, uint32_t a, uint32_t k, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+fors_sign()
+{
+  constexpr uint64_t t = 1ul << a;
+  return prf(k * t) + t_l<n, 1, v>(k * (t - 1)) + t_l<n, 2, v>(k * (t - 1 - a));
+}
+
+// FORS public key computation from signature, see `sphincs_plus_fors::pk_from_sig`, independent of message.
+template<size_t n, uint32_t a, uint32_t k, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+fors_pk_from_sig()
+{
+  return t_l<n, 1, v>(k) + t_l<n, 2, v>(k * a) + t_l<n, k, v>();
+}
+
+// SPHINCS+ key generation, computing root of the only XMSS tree on top layer of HyperTree.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+keygen()
+{
+  return xmss_pkgen<h / d, n, w, v>();
+}
+
+// SPHINCS+ signing of mlen -bytes message, see `sphincs_plus::sign`, which is independent of message digits, as each
+// of d -many XMSS trees, on the path, is computed in full.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+sign(const size_t mlen)
+{
+  return prf_msg<n>(mlen) + h_msg<n, h, d, a, k>(mlen) + fors_sign<n, a, k, v>() + fors_pk_from_sig<n, a, k, v>() +
+         xmss_pkgen<h / d, n, w, v>() * d;
+}
+
+// SPHINCS+ verification of mlen -bytes message, see `sphincs_plus::verify`, when `steps` -many WOTS+ chain steps are
+// left to be walked, over all d -many WOTS+ signatures, without any verified-node cache.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr counters_t
+verify(const size_t mlen, const uint64_t steps)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  return h_msg<n, h, d, a, k>(mlen) + fors_pk_from_sig<n, a, k, v>() + t_l<n, 1, v>(steps) + t_l<n, len, v>(d) + t_l<n, 2, v>(h);
+}
+
+// Given checksum of base-w digits of a WOTS+ message, this routine computes # -of F calls, verifier spends on chains
+// of checksum digits, following `sphincs_plus_wots::compute_digits`.
+template<size_t n, size_t w>
+static inline constexpr uint64_t
+checksum_steps(uint32_t csum)
+{
+  constexpr size_t lgw = sphincs_plus_utils::log2<w>();
+  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
+  constexpr size_t len2 = sphincs_plus_utils::compute_wots_len2<n, w, len1>();
+  constexpr size_t len_2_bytes = (len2 * lgw + 7ul) >> 3;
+
+  if constexpr (((len2 * lgw) & 7ul) != 0) {
+    csum <<= (8ul - ((len2 * lgw) & 7ul));
+  }
+
+  // Only lower len_2_bytes -bytes of checksum are serialized, whose base-w digits are read from most significant end
+  const uint64_t bytes = static_cast<uint64_t>(csum) & ((1ul << (len_2_bytes << 3)) - 1ul);
+
+  uint64_t steps = 0;
+  for (size_t i = 0; i < len2; i++) {
+    const size_t off = (len_2_bytes << 3) - (i + 1) * lgw;
+    steps += (w - 1) - ((bytes >> off) & (w - 1));
+  }
+
+  return steps;
+}
+
+// Given checksum of base-w digits of a WOTS+ message, this routine computes # -of F calls, verifier spends on all len
+// -many chains. Chains of message digits need exactly `csum` -many steps.
+template<size_t n, size_t w>
+static inline constexpr uint64_t
+wots_verify_steps(const uint32_t csum)
+{
+  return static_cast<uint64_t>(csum) + checksum_steps<n, w>(csum);
+}
+
+// Min, max and average # -of F calls, verifier spends on WOTS+ chains.
+struct steps_t
+{
+  uint64_t min = 0;
+  uint64_t max = 0;
+  double avg = 0.;
+};
+
+// Compile-time compute min, max and average # -of F calls, verifier spends on chains of a single WOTS+ signature, over
+// all n -bytes messages. Checksum is sum of len1 -many uniformly random values in [0, w-1], whose distribution is
+// computed one digit at a time, using a sliding window sum.
+template<size_t n, size_t w>
+static inline constexpr steps_t
+wots_verify_steps()
+{
+  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
+  constexpr size_t max_csum = len1 * (w - 1);
+
+  // Distribution of sum of first i digits, ping-ponging between two tables, each of which is only filled up to max sum
+  std::array<std::array<double, max_csum + 1>, 2> prob{};
+  prob[0][0] = 1.;
+
+  for (size_t i = 0; i < len1; i++) {
+    const auto& cur = prob[i & 1];
+    auto& next = prob[(i + 1) & 1];
+
+    double window = 0.;
+    for (size_t s = 0; s <= (i + 1) * (w - 1); s++) {
+      window += (s <= i * (w - 1)) ? cur[s] : 0.;
+      if (s >= w) {
+        window -= cur[s - w];
+      }
+
+      next[s] = window / static_cast<double>(w);
+    }
+  }
+
+  steps_t res{ UINT64_MAX, 0, 0. };
+  for (size_t c = 0; c <= max_csum; c++) {
+    const uint64_t steps = wots_verify_steps<n, w>(static_cast<uint32_t>(c));
+
+    res.min = std::min(res.min, steps);
+    res.max = std::max(res.max, steps);
+    res.avg += prob[len1 & 1][c] * static_cast<double>(steps);
+  }
+
+  return res;
+}
+
+// Cost of SPHINCS+ verification, which depends on message digits, summarized by its min, max and average.
+struct verify_cost_t
+{
+  counters_t min{};
+  counters_t max{};
+  double avg_calls = 0.;
+  double avg_permutations = 0.;
+};
+
+// Compile-time evaluable routine, computing min, max and average cost of SPHINCS+ verification of mlen -bytes message,
+// over all signatures. Each of d -many WOTS+ signatures is over an independent, uniformly random digest.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr verify_cost_t
+verify_cost(const size_t mlen)
+{
+  constexpr steps_t steps = wots_verify_steps<n, w>();
+  constexpr uint64_t f_perms = sphincs_plus_hashing::t_l_permutations<n, 1, v>();
+
+  const counters_t base = verify<n, h, d, a, k, w, v>(mlen, 0);
+  const double avg_steps = static_cast<double>(d) * steps.avg;
+
+  const counters_t min = verify<n, h, d, a, k, w, v>(mlen, d * steps.min);
+  const counters_t max = verify<n, h, d, a, k, w, v>(mlen, d * steps.max);
+  const double avg_calls = static_cast<double>(base.get_total_calls()) + avg_steps;
+  const double avg_permutations = static_cast<double>(base.permutations) + avg_steps * static_cast<double>(f_perms);
+
+  return verify_cost_t{ min, max, avg_calls, avg_permutations };
+}
+
+// Compile-time compute byte length of workspace, which can be passed to key generation and signing, so that subtrees
+// are computed off the call stack, see `sphincs_plus_xmss::workspace_t`.
+template<size_t n>
+static inline constexpr size_t
+workspace_bytes()
+{
+  return sizeof(sphincs_plus_xmss::workspace_t<n>);
+}
+
+// Compile-time compute byte length of flat XMSS tree, batch signing keeps around, see `sphincs_plus_multi::sign`.
+template<uint32_t h, uint32_t d, size_t n>
+static inline constexpr size_t
+multi_sign_tree_bytes()
+{
+  return sphincs_plus_xmss::get_tree_len<h / d, n>();
+}
+
+// Computes byte length of tables of a verified-node cache, remembering at max `capacity` -many XMSS tree roots per
+// HyperTree layer, see `sphincs_plus_node_cache::node_cache_t`, when each entry is laid out in n + 16 -bytes.
+template<uint32_t h, uint32_t d, size_t n>
+static inline constexpr size_t
+node_cache_bytes(const size_t capacity)
+{
+  constexpr uint32_t h_ = h / d;
+
+  const size_t slots = std::bit_ceil(std::max<size_t>(capacity, 1));
+  const uint32_t log2_slots = static_cast<uint32_t>(std::countr_zero(slots));
+
+  size_t bytes = 0;
+  for (uint32_t j = 0; j + 1 < d; j++) {
+    bytes += (1ul << std::min(log2_slots, h - (j + 1) * h_)) * (n + 16);
+  }
+
+  return bytes;
+}
+
+}
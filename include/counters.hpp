@@ -0,0 +1,117 @@
+#pragma once
+#include "keccak.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Opt-in counters of tweakable hash function, PRF and Keccak-f[1600] permutation invocations, for SPHINCS+-SHAKE
+namespace sphincs_plus_counters {
+
+// Counting is enabled only when compiled with `-DSPHINCS_PLUS_COUNTERS`, otherwise recording a hash call compiles down
+// to nothing.
+#if defined SPHINCS_PLUS_COUNTERS
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// Hash functions, whose invocations are counted, see section 7.2.1 of SPHINCS+ specification
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+enum class hash_t : size_t
+{
+  f = 0,   // T_l | l = 1
+  h = 1,   // T_l | l = 2
+  t_l = 2, // T_l | l > 2, compressing WOTS+ public key or FORS roots
+  prf = 3,
+  prf_msg = 4,
+  h_msg = 5,
+};
+
+// # -of variants of `hash_t`
+constexpr size_t HASH_KIND_CNT = 6;
+
+// Invocations of each hash function and Keccak-f[1600] permutations they required, on a single thread.
+struct counters_t
+{
+  std::array<uint64_t, HASH_KIND_CNT> calls{};
+  uint64_t permutations = 0;
+
+  // Returns # -of invocations of given hash function.
+  inline constexpr uint64_t get_calls(const hash_t kind) const { return calls[static_cast<size_t>(kind)]; }
+
+  // Returns # -of invocations of all hash functions.
+  inline constexpr uint64_t get_total_calls() const
+  {
+    uint64_t total = 0;
+    for (const uint64_t c : calls) {
+      total += c;
+    }
+
+    return total;
+  }
+
+  // Counters of invocations made by either of two pieces of work.
+  inline constexpr counters_t operator+(const counters_t& rhs) const
+  {
+    counters_t res{};
+    for (size_t i = 0; i < HASH_KIND_CNT; i++) {
+      res.calls[i] = calls[i] + rhs.calls[i];
+    }
+    res.permutations = permutations + rhs.permutations;
+
+    return res;
+  }
+
+  // Counters of invocations made by repeating same piece of work `cnt` -many times.
+  inline constexpr counters_t operator*(const uint64_t cnt) const
+  {
+    counters_t res{};
+    for (size_t i = 0; i < HASH_KIND_CNT; i++) {
+      res.calls[i] = calls[i] * cnt;
+    }
+    res.permutations = permutations * cnt;
+
+    return res;
+  }
+
+  inline constexpr bool operator==(const counters_t&) const = default;
+};
+
+// Counters of calling thread, kept per thread, so that recording an invocation is a plain increment.
+inline thread_local counters_t counters{};
+
+// Returns # -of Keccak-f[1600] permutations, SHAKE256 requires for absorbing ilen -bytes and squeezing olen (>0) -bytes.
+static inline constexpr uint64_t
+shake256_permutations(const size_t ilen, const size_t olen)
+{
+  constexpr size_t rate = sphincs_plus_keccak::SHAKE256_RATE;
+  return static_cast<uint64_t>(ilen / rate + 1 + (olen - 1) / rate);
+}
+
+// Records `cnt` -many invocations of hash function of given kind, each of which required `perms` -many Keccak-f[1600]
+// permutations, on calling thread.
+template<hash_t kind>
+static inline void
+record(const uint64_t perms, const uint64_t cnt = 1)
+{
+  if constexpr (ENABLED) {
+    counters.calls[static_cast<size_t>(kind)] += cnt;
+    counters.permutations += perms * cnt;
+  }
+}
+
+// Returns counters of calling thread.
+static inline counters_t
+get()
+{
+  return counters;
+}
+
+// Resets counters of calling thread.
+static inline void
+reset()
+{
+  counters = counters_t{};
+}
+
+}
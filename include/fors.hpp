@@ -1,5 +1,6 @@
 #pragma once
 #include "address.hpp"
+#include "tracing.hpp"
 #include "xmss.hpp"
 
 // FORS: Forest of Random Subsets
@@ -24,7 +25,7 @@ skgen(std::span<const uint8_t, n> pk_seed,
   prf_adrs.set_keypair_address(adrs.get_keypair_address());
   prf_adrs.set_tree_index(idx);
 
-  sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, prf_adrs.data, skey);
+  sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, prf_adrs, skey);
 }
 
 // Computes n -bytes root node of a subtree ( in the FORS tree ) of height
@@ -36,65 +37,32 @@ skgen(std::span<const uint8_t, n> pk_seed,
 // in section 4.1.3 of the specification, which describes treehash algorithm,
 // for computing n -bytes root node of subtree of height z, in main (binary)
 // Merkle Tree.
+//
+// Nodes are computed level by level, see `sphincs_plus_xmss::level_treehash`,
+// optionally using caller-supplied workspace.
 template<size_t n, sphincs_plus_hashing::variant v>
 static inline void
 treehash(std::span<const uint8_t, n> sk_seed,
          const uint32_t s_idx,
          const uint32_t n_height,
          std::span<const uint8_t, n> pk_seed,
-         sphincs_plus_adrs::fors_tree_t adrs,
-         std::span<uint8_t, n> root)
+         const sphincs_plus_adrs::fors_tree_t adrs,
+         std::span<uint8_t, n> root,
+         sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
 {
-  // # -of leafs in the subtree
-  const uint32_t leaf_cnt = 1u << n_height;
-
-  // Stack holding at max `n_height` many intermediate nodes of FORS tree
-  std::stack<sphincs_plus_xmss::node_t<n>> stack;
-  std::array<uint8_t, n> sk_val{};
-
-  for (uint32_t i = 0; i < leaf_cnt; i++) {
-    skgen<n>(pk_seed, sk_seed, adrs, s_idx + i, sk_val);
-
-    adrs.set_tree_height(0u);
-    adrs.set_tree_index(s_idx + i);
+  auto leaf = [&](const uint32_t idx, std::span<uint8_t, n> node) {
+    std::array<uint8_t, n> sk_val{};
+    skgen<n>(pk_seed, sk_seed, adrs, idx, sk_val);
 
-    sphincs_plus_xmss::node_t<n> node{};
-    sphincs_plus_hashing::f<n, v>(pk_seed, adrs.data, sk_val, node.data);
-    node.height = 1u;
-
-    adrs.set_tree_height(1u);
-    adrs.set_tree_index(s_idx + i);
-
-    // Two consecutive nodes, each of n -bytes width
-    //
-    // Used for computing parent node of binary FORS Tree, from two children
-    std::array<uint8_t, n + n> c_nodes{};
-    auto _c_nodes = std::span(c_nodes);
-
-    while (!stack.empty()) {
-      const auto top = stack.top();
-      if (top.height != node.height) {
-        break;
-      }
+    sphincs_plus_adrs::fors_tree_t leaf_adrs{ adrs };
 
-      adrs.set_tree_index((adrs.get_tree_index() - 1u) >> 1);
+    leaf_adrs.set_tree_height(0u);
+    leaf_adrs.set_tree_index(idx);
 
-      std::copy(top.data.begin(), top.data.end(), _c_nodes.template subspan<0, n>().begin());
-      std::copy(node.data.begin(), node.data.end(), _c_nodes.template subspan<n, n>().begin());
+    sphincs_plus_hashing::f<n, v>(pk_seed, leaf_adrs, sk_val, node);
+  };
 
-      sphincs_plus_hashing::h<n, v>(pk_seed, adrs.data, _c_nodes, node.data);
-      node.height = adrs.get_tree_height() + 1u;
-
-      adrs.set_tree_height(adrs.get_tree_height() + 1u);
-      stack.pop();
-    }
-
-    stack.push(node);
-  }
-
-  const sphincs_plus_xmss::node_t<n> top = stack.top();
-  std::copy(top.data.begin(), top.data.end(), root.begin());
-  stack.pop(); // Drop root of FORS subtree, stack is empty now.
+  sphincs_plus_xmss::level_treehash<n, v>(pk_seed, s_idx, n_height, adrs, leaf, root, ws);
 }
 
 // Computes a n -bytes FORS public key, given n -bytes secret key seed, n -bytes
@@ -103,7 +71,11 @@ treehash(std::span<const uint8_t, n> sk_seed,
 // the specification https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n, uint32_t a, uint32_t k, sphincs_plus_hashing::variant v>
 static inline void
-pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed, const sphincs_plus_adrs::fors_tree_t adrs, std::span<uint8_t, n> pkey)
+pkgen(std::span<const uint8_t, n> sk_seed,
+      std::span<const uint8_t, n> pk_seed,
+      const sphincs_plus_adrs::fors_tree_t adrs,
+      std::span<uint8_t, n> pkey,
+      sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
 {
   constexpr uint32_t t = 1u << a; // # -of leaves in FORS subtree
   std::array<uint8_t, k * n> roots{};
@@ -111,7 +83,7 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
 
   for (uint32_t i = 0; i < k; i++) {
     const size_t off = static_cast<size_t>(i) * n;
-    treehash<n, v>(sk_seed, i * t, a, pk_seed, adrs, std::span<uint8_t, n>(_roots.subspan(off, n)));
+    treehash<n, v>(sk_seed, i * t, a, pk_seed, adrs, std::span<uint8_t, n>(_roots.subspan(off, n)), ws);
   }
 
   sphincs_plus_adrs::fors_roots_t roots_adrs{ adrs };
@@ -119,7 +91,7 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
   roots_adrs.set_type(sphincs_plus_adrs::type_t::FORS_ROOTS);
   roots_adrs.set_keypair_address(adrs.get_keypair_address());
 
-  sphincs_plus_hashing::t_l<n, k, v>(pk_seed, roots_adrs.data, roots, pkey);
+  sphincs_plus_hashing::t_l<n, k, v>(pk_seed, roots_adrs, roots, pkey);
 }
 
 // Computes k * n * (a + 1) -bytes FORS signature over message of ⌈(k * a) / 8⌉
@@ -134,7 +106,8 @@ sign(std::span<const uint8_t, ((k * a) + 7) / 8> msg,
      std::span<const uint8_t, n> sk_seed,
      std::span<const uint8_t, n> pk_seed,
      const sphincs_plus_adrs::fors_tree_t adrs,
-     std::span<uint8_t, (k * n * (a + 1))> sig)
+     std::span<uint8_t, (k * n * (a + 1))> sig,
+     sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
 {
   constexpr uint32_t t = 1u << a; // # -of leaves in FORS subtree
 
@@ -142,6 +115,10 @@ sign(std::span<const uint8_t, ((k * a) + 7) / 8> msg,
   constexpr size_t auth_path_len = static_cast<size_t>(a) * n;
   constexpr size_t sig_elm_len = skey_val_len + auth_path_len;
 
+  namespace tracing = sphincs_plus_tracing;
+  constexpr uint64_t params = tracing::params<n, 0u, 0u, a, k, 0u, v>();
+  tracing::begin(tracing::phase_t::fors_sign, 0u, params);
+
   for (uint32_t i = 0; i < k; i++) {
     const size_t frm = i * a;
     const size_t to = (i + 1) * a - 1;
@@ -157,9 +134,11 @@ sign(std::span<const uint8_t, ((k * a) + 7) / 8> msg,
       const size_t off2 = off1 + j * n;
 
       const uint32_t s = (idx >> j) ^ 1u;
-      treehash<n, v>(sk_seed, i * t + (s << j), j, pk_seed, adrs, std::span<uint8_t, n>(sig.subspan(off2, n)));
+      treehash<n, v>(sk_seed, i * t + (s << j), j, pk_seed, adrs, std::span<uint8_t, n>(sig.subspan(off2, n)), ws);
     }
   }
+
+  tracing::end(tracing::phase_t::fors_sign, 0u, params);
 }
 
 // Computes n -bytes FORS public key, from k * n * (a + 1) -bytes FORS
@@ -202,7 +181,7 @@ pk_from_sig(std::span<const uint8_t, (k * n * (a + 1))> sig,
     adrs.set_tree_height(0u);
     adrs.set_tree_index(i * t + idx);
 
-    sphincs_plus_hashing::f<n, v>(pk_seed, adrs.data, std::span<const uint8_t, n>(sig.subspan(off0, skey_val_len)), _c_nodes.template subspan<0, n>());
+    sphincs_plus_hashing::f<n, v>(pk_seed, adrs, std::span<const uint8_t, n>(sig.subspan(off0, skey_val_len)), _c_nodes.template subspan<0, n>());
 
     for (uint32_t j = 0; j < a; j++) {
       const size_t off2 = off1 + j * n;
@@ -215,7 +194,7 @@ pk_from_sig(std::span<const uint8_t, (k * n * (a + 1))> sig,
         auto _sig = std::span<const uint8_t, n>(sig.subspan(off2, n));
         std::copy(_sig.begin(), _sig.end(), _c_nodes.template subspan<n, n>().begin());
 
-        sphincs_plus_hashing::h<n, v>(pk_seed, adrs.data, _c_nodes, tmp);
+        sphincs_plus_hashing::h<n, v>(pk_seed, adrs, _c_nodes, tmp);
 
         std::copy(tmp.begin(), tmp.end(), _c_nodes.template subspan<n, n>().begin());
       } else {
@@ -227,7 +206,7 @@ pk_from_sig(std::span<const uint8_t, (k * n * (a + 1))> sig,
         auto _sig = std::span<const uint8_t, n>(sig.subspan(off2, n));
         std::copy(_sig.begin(), _sig.end(), _c_nodes.template subspan<0, n>().begin());
 
-        sphincs_plus_hashing::h<n, v>(pk_seed, adrs.data, _c_nodes, tmp);
+        sphincs_plus_hashing::h<n, v>(pk_seed, adrs, _c_nodes, tmp);
 
         std::copy(tmp.begin(), tmp.end(), _c_nodes.template subspan<n, n>().begin());
       }
@@ -246,7 +225,7 @@ pk_from_sig(std::span<const uint8_t, (k * n * (a + 1))> sig,
   roots_adrs.set_type(sphincs_plus_adrs::type_t::FORS_ROOTS);
   roots_adrs.set_keypair_address(adrs.get_keypair_address());
 
-  sphincs_plus_hashing::t_l<n, k, v>(pk_seed, roots_adrs.data, roots, pkey);
+  sphincs_plus_hashing::t_l<n, k, v>(pk_seed, roots_adrs, roots, pkey);
 }
 
 }
@@ -1,4 +1,7 @@
 #pragma once
+#include "address.hpp"
+#include "counters.hpp"
+#include "keccak.hpp"
 #include "shake256.hpp"
 #include <array>
 #include <cstring>
@@ -42,30 +45,32 @@ h_msg(std::span<const uint8_t, n> r,
   hasher.absorb(msg);
   hasher.finalize();
   hasher.squeeze(dig);
+
+  sphincs_plus_counters::record<sphincs_plus_counters::hash_t::h_msg>(sphincs_plus_counters::shake256_permutations(tmp.size() + msg.size(), m));
 }
 
 // Given n -bytes public key seed, n -bytes secret key seed and 32 -bytes
 // address, this routine makes use of SHAKE256, as pseudorandom function, for
-// generating pseudorandom key of byte length n.
+// generating pseudorandom key of byte length n. Input fits in a single block
+// of SHAKE256, so it's computed using in-tree Keccak-f[1600] permutation.
 //
 // See section 7.2.1 of Sphincs+ specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n>
 static inline constexpr void
-prf(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, 32> adrs, std::span<uint8_t, n> dig)
+prf(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, n> sk_seed, const sphincs_plus_adrs::adrs_t& adrs, std::span<uint8_t, n> dig)
 {
-  std::array<uint8_t, pk_seed.size() + adrs.size() + sk_seed.size()> tmp{};
+  constexpr size_t alen = sphincs_plus_adrs::ADRS_BYTE_WIDTH;
+
+  std::array<uint8_t, pk_seed.size() + alen + sk_seed.size()> tmp{};
   auto _tmp = std::span(tmp);
 
   std::copy(pk_seed.begin(), pk_seed.end(), _tmp.template subspan<0, pk_seed.size()>().begin());
-  std::copy(adrs.begin(), adrs.end(), _tmp.template subspan<pk_seed.size(), adrs.size()>().begin());
-  std::copy(sk_seed.begin(), sk_seed.end(), _tmp.template subspan<pk_seed.size() + adrs.size(), sk_seed.size()>().begin());
-
-  shake256::shake256_t hasher;
+  adrs.to_bytes(_tmp.template subspan<pk_seed.size(), alen>());
+  std::copy(sk_seed.begin(), sk_seed.end(), _tmp.template subspan<pk_seed.size() + alen, sk_seed.size()>().begin());
 
-  hasher.absorb(tmp);
-  hasher.finalize();
-  hasher.squeeze(dig);
+  sphincs_plus_keccak::shake256<tmp.size(), n>(tmp, dig);
+  sphincs_plus_counters::record<sphincs_plus_counters::hash_t::prf>(1);
 }
 
 // Given n -bytes secret key prf, n -bytes OptRand and mlen -bytes message ( to
@@ -90,29 +95,30 @@ prf_msg(std::span<const uint8_t, n> sk_prf, std::span<const uint8_t, n> opt_rand
   hasher.absorb(msg);
   hasher.finalize();
   hasher.squeeze(dig);
+
+  sphincs_plus_counters::record<sphincs_plus_counters::hash_t::prf_msg>(sphincs_plus_counters::shake256_permutations(tmp.size() + msg.size(), n));
 }
 
-// Given n -bytes public key seed, 32 -bytes address and n * l -bytes message,
-// this routine uses SHAKE256, in XOF mode, for generating a bit mask of length
-// n * l -bytes, which is XOR-ed into the message for producing masked message.
+// Given n + 32 -bytes prefix ( = n -bytes public key seed || 32 -bytes
+// serialized address ) and n * l -bytes message, this routine uses SHAKE256,
+// in XOF mode, for generating a bit mask of length n * l -bytes, which is
+// XOR-ed into the message for producing masked message.
 //
 // See section 7.2.1 of Sphincs+ specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n, size_t l>
 static inline void
-gen_mask(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std::span<const uint8_t, n * l> msg, std::span<uint8_t, n * l> dig)
+gen_mask(std::span<const uint8_t, n + sphincs_plus_adrs::ADRS_BYTE_WIDTH> prefix, std::span<const uint8_t, n * l> msg, std::span<uint8_t, n * l> dig)
 {
-  std::array<uint8_t, pk_seed.size() + adrs.size()> tmp{};
-  auto _tmp = std::span(tmp);
-
-  std::copy(pk_seed.begin(), pk_seed.end(), _tmp.template subspan<0, pk_seed.size()>().begin());
-  std::copy(adrs.begin(), adrs.end(), _tmp.template subspan<pk_seed.size(), adrs.size()>().begin());
-
-  shake256::shake256_t hasher;
+  if constexpr (n * l <= sphincs_plus_keccak::SHAKE256_RATE) {
+    sphincs_plus_keccak::shake256<prefix.size(), n * l>(prefix, dig);
+  } else {
+    shake256::shake256_t hasher;
 
-  hasher.absorb(tmp);
-  hasher.finalize();
-  hasher.squeeze(dig);
+    hasher.absorb(prefix);
+    hasher.finalize();
+    hasher.squeeze(dig);
+  }
 
 #if defined __clang__
 #pragma clang loop unroll(enable)
@@ -126,40 +132,151 @@ gen_mask(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs,
   }
 }
 
+// Whether input of T_l ( = n -bytes public key seed || 32 -bytes address ||
+// n * l -bytes message ) fits in a single block of SHAKE256, which is the case
+// for F and H, so that T_l can be computed using in-tree Keccak-f[1600]
+// permutation, instead of incremental SHAKE256.
+template<size_t n, size_t l>
+static inline constexpr bool
+is_single_block()
+{
+  return (n + sphincs_plus_adrs::ADRS_BYTE_WIDTH + n * l) < sphincs_plus_keccak::SHAKE256_RATE;
+}
+
+// Compile-time compute # -of Keccak-f[1600] permutations, a single T_l call
+// requires, including the ones for generating bitmask, in robust variant.
+template<size_t n, size_t l, variant v>
+static inline constexpr uint64_t
+t_l_permutations()
+{
+  using sphincs_plus_counters::shake256_permutations;
+
+  constexpr size_t plen = n + sphincs_plus_adrs::ADRS_BYTE_WIDTH;
+  return shake256_permutations(plen + n * l, n) + ((v == variant::robust) ? shake256_permutations(plen, n * l) : 0);
+}
+
+// Records `cnt` -many invocations of T_l, counted as F when l = 1 and as H
+// when l = 2, along with Keccak-f[1600] permutations each of them requires,
+// when hash counters are enabled.
+template<size_t n, size_t l, variant v>
+static inline void
+record_t_l(const uint64_t cnt = 1)
+{
+  using sphincs_plus_counters::hash_t;
+
+  constexpr hash_t kind = (l == 1) ? hash_t::f : ((l == 2) ? hash_t::h : hash_t::t_l);
+  sphincs_plus_counters::record<kind>(t_l_permutations<n, l, v>(), cnt);
+}
+
+// Given n + 32 -bytes prefix ( = n -bytes public key seed || 32 -bytes
+// serialized address ) and n * l -bytes message, this routines uses SHAKE256,
+// for constructing a tweakable hash function, producing n -bytes output.
+//
+// Callers hashing many times under addresses which differ in a single word,
+// e.g. consecutive steps of a WOTS+ chain, can keep the prefix around and only
+// rewrite that word, see `sphincs_plus_adrs::adrs_t::word_to_bytes`.
+template<size_t n, size_t l, variant v>
+static inline constexpr void
+t_l_prefixed(std::span<const uint8_t, n + sphincs_plus_adrs::ADRS_BYTE_WIDTH> prefix, std::span<const uint8_t, n * l> msg, std::span<uint8_t, n> dig)
+{
+  if constexpr (is_single_block<n, l>()) {
+    std::array<uint8_t, prefix.size() + msg.size()> tmp{};
+    auto _tmp = std::span(tmp);
+
+    std::copy(prefix.begin(), prefix.end(), _tmp.template subspan<0, prefix.size()>().begin());
+
+    if constexpr (v == variant::robust) {
+      gen_mask<n, l>(prefix, msg, _tmp.template subspan<prefix.size(), msg.size()>());
+    } else {
+      std::copy(msg.begin(), msg.end(), _tmp.template subspan<prefix.size(), msg.size()>().begin());
+    }
+
+    sphincs_plus_keccak::shake256<tmp.size(), n>(tmp, dig);
+  } else {
+    shake256::shake256_t hasher;
+
+    hasher.absorb(prefix);
+
+    if constexpr (v == variant::robust) {
+      std::array<uint8_t, msg.size()> masked{};
+      gen_mask<n, l>(prefix, msg, masked);
+
+      hasher.absorb(masked);
+    } else {
+      hasher.absorb(msg);
+    }
+
+    hasher.finalize();
+    hasher.squeeze(dig);
+  }
+
+  record_t_l<n, l, v>();
+}
+
+// Given `ways` -many n + 32 -bytes prefixes and n * l -bytes messages, this
+// routine computes `ways` -many independent T_l calls, each of which fits in a
+// single block of SHAKE256, interleaving their Keccak-f[1600] permutations.
+template<size_t n, size_t l, variant v, size_t ways>
+static inline void
+t_l_prefixed_batch(std::span<const uint8_t, ways *(n + sphincs_plus_adrs::ADRS_BYTE_WIDTH)> prefixes,
+                   std::span<const uint8_t, ways * n * l> msgs,
+                   std::span<uint8_t, ways * n> digs)
+  requires(is_single_block<n, l>())
+{
+  constexpr size_t plen = n + sphincs_plus_adrs::ADRS_BYTE_WIDTH;
+  constexpr size_t mlen = n * l;
+  constexpr size_t tlen = plen + mlen;
+
+  std::array<uint8_t, ways * tlen> tmp{};
+  auto _tmp = std::span(tmp);
+
+  for (size_t i = 0; i < ways; i++) {
+    auto prefix = prefixes.subspan(i * plen, plen);
+    auto msg = msgs.subspan(i * mlen, mlen);
+    auto in = _tmp.subspan(i * tlen, tlen);
+
+    std::copy(prefix.begin(), prefix.end(), in.begin());
+    std::copy(msg.begin(), msg.end(), in.subspan(plen, mlen).begin());
+  }
+
+  if constexpr (v == variant::robust) {
+    std::array<uint8_t, ways * mlen> masks{};
+    sphincs_plus_keccak::shake256<plen, mlen, ways>(prefixes, masks);
+
+    for (size_t i = 0; i < ways; i++) {
+      auto masked = _tmp.subspan(i * tlen + plen, mlen);
+
+      for (size_t j = 0; j < mlen; j++) {
+        masked[j] ^= masks[i * mlen + j];
+      }
+    }
+  }
+
+  sphincs_plus_keccak::shake256<tlen, n, ways>(tmp, digs);
+  record_t_l<n, l, v>(ways);
+}
+
 // Given n -bytes public key seed, 32 -bytes address and n * l -bytes message,
 // this routines uses SHAKE256, for constructing a tweakable hash function,
 // producing n -bytes output.
 //
 // Note, this routine supports compile-time parameterization, to be used as
-// robust or simple variant of T_l routine.
+// robust or simple variant of T_l routine. Address is serialized straight
+// into input of SHAKE256.
 //
 // See section 7.2.1 of Sphincs+ specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n, size_t l, variant v>
 static inline constexpr void
-t_l(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std::span<const uint8_t, n * l> msg, std::span<uint8_t, n> dig)
+t_l(std::span<const uint8_t, n> pk_seed, const sphincs_plus_adrs::adrs_t& adrs, std::span<const uint8_t, n * l> msg, std::span<uint8_t, n> dig)
 {
-  std::array<uint8_t, pk_seed.size() + adrs.size()> tmp{};
-  auto _tmp = std::span(tmp);
-
-  std::copy(pk_seed.begin(), pk_seed.end(), _tmp.template subspan<0, pk_seed.size()>().begin());
-  std::copy(adrs.begin(), adrs.end(), _tmp.template subspan<pk_seed.size(), adrs.size()>().begin());
+  std::array<uint8_t, pk_seed.size() + sphincs_plus_adrs::ADRS_BYTE_WIDTH> prefix{};
+  auto _prefix = std::span(prefix);
 
-  shake256::shake256_t hasher;
-
-  hasher.absorb(tmp);
+  std::copy(pk_seed.begin(), pk_seed.end(), _prefix.template subspan<0, pk_seed.size()>().begin());
+  adrs.to_bytes(_prefix.template subspan<pk_seed.size(), sphincs_plus_adrs::ADRS_BYTE_WIDTH>());
 
-  if constexpr (v == variant::robust) {
-    std::array<uint8_t, msg.size()> masked{};
-    gen_mask<n, l>(pk_seed, adrs, msg, masked);
-
-    hasher.absorb(masked);
-  } else {
-    hasher.absorb(msg);
-  }
-
-  hasher.finalize();
-  hasher.squeeze(dig);
+  t_l_prefixed<n, l, v>(prefix, msg, dig);
 }
 
 // Given n -bytes public key seed, 32 -bytes address and n -bytes message,
@@ -175,11 +292,73 @@ t_l(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std:
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n, variant v>
 static inline constexpr void
-f(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std::span<const uint8_t, n> msg, std::span<uint8_t, n> dig)
+f(std::span<const uint8_t, n> pk_seed, const sphincs_plus_adrs::adrs_t& adrs, std::span<const uint8_t, n> msg, std::span<uint8_t, n> dig)
 {
   t_l<n, 1, v>(pk_seed, adrs, msg, dig);
 }
 
+// Given `lanes` -many addresses and n * l -bytes messages, this routine
+// computes `lanes` -many independent T_l calls, `sphincs_plus_keccak::WAYS` of
+// them at a time, when each fits in a single block of SHAKE256.
+template<size_t n, size_t l, variant v, size_t lanes>
+static inline void
+t_l_batch(std::span<const uint8_t, n> pk_seed,
+          std::span<const sphincs_plus_adrs::adrs_t, lanes> adrs,
+          std::span<const uint8_t, lanes * n * l> msgs,
+          std::span<uint8_t, lanes * n> digs)
+{
+  constexpr size_t plen = n + sphincs_plus_adrs::ADRS_BYTE_WIDTH;
+  constexpr size_t mlen = n * l;
+  constexpr size_t ways = sphincs_plus_keccak::WAYS;
+
+  size_t i = 0;
+
+  if constexpr (is_single_block<n, l>()) {
+    std::array<uint8_t, ways * plen> prefixes{};
+    auto _prefixes = std::span(prefixes);
+
+    for (; i + ways <= lanes; i += ways) {
+      for (size_t j = 0; j < ways; j++) {
+        auto prefix = std::span<uint8_t, plen>(_prefixes.subspan(j * plen, plen));
+
+        std::copy(pk_seed.begin(), pk_seed.end(), prefix.template subspan<0, n>().begin());
+        adrs[i + j].to_bytes(prefix.template subspan<n, sphincs_plus_adrs::ADRS_BYTE_WIDTH>());
+      }
+
+      t_l_prefixed_batch<n, l, v, ways>(prefixes,
+                                        std::span<const uint8_t, ways * mlen>(msgs.subspan(i * mlen, ways * mlen)),
+                                        std::span<uint8_t, ways * n>(digs.subspan(i * n, ways * n)));
+    }
+  }
+
+  for (; i < lanes; i++) {
+    t_l<n, l, v>(pk_seed,
+                 adrs[i],
+                 std::span<const uint8_t, mlen>(msgs.subspan(i * mlen, mlen)),
+                 std::span<uint8_t, n>(digs.subspan(i * n, n)));
+  }
+}
+
+// # -of independent F calls, issued together, by WOTS+ chain scheduler
+constexpr size_t F_LANES = 4;
+
+// Given n -bytes public key seed, lanes -many addresses and lanes * n -bytes
+// messages, this routine computes lanes -many independent F calls,
+// producing lanes * n -bytes output s.t. i -th n -bytes digest is F of i -th
+// address and i -th n -bytes message.
+//
+// Note, lanes are hashed `sphincs_plus_keccak::WAYS` at a time, same as
+// `h_batch`.
+template<size_t n, variant v, size_t lanes>
+static inline constexpr void
+f_batch(std::span<const uint8_t, n> pk_seed,
+        std::span<const sphincs_plus_adrs::adrs_t, lanes> adrs,
+        std::span<const uint8_t, lanes * n> msgs,
+        std::span<uint8_t, lanes * n> digs)
+{
+  t_l_batch<n, 1, v, lanes>(pk_seed, adrs, msgs, digs);
+}
+
 // Given n -bytes public key seed, 32 -bytes address and 2*n -bytes message,
 // this routines uses SHAKE256, for constructing a tweakable hash function,
 // producing n -bytes output.
@@ -193,9 +372,32 @@ f(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std::s
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<size_t n, variant v>
 static inline constexpr void
-h(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, 32> adrs, std::span<const uint8_t, 2 * n> msg, std::span<uint8_t, n> dig)
+h(std::span<const uint8_t, n> pk_seed, const sphincs_plus_adrs::adrs_t& adrs, std::span<const uint8_t, 2 * n> msg, std::span<uint8_t, n> dig)
 {
   t_l<n, 2, v>(pk_seed, adrs, msg, dig);
 }
 
+// # -of independent H calls, issued together, by level-synchronous tree builders
+constexpr size_t H_LANES = 4;
+
+// Given n -bytes public key seed, lanes -many addresses and lanes * 2*n -bytes
+// messages, this routine computes lanes -many independent H calls,
+// producing lanes * n -bytes output s.t. i -th n -bytes digest is H of i -th
+// address and i -th 2*n -bytes message.
+//
+// Note, input of H fits in a single block of SHAKE256, so lanes are hashed
+// `sphincs_plus_keccak::WAYS` at a time, interleaving their Keccak-f[1600]
+// permutations. Callers are expected to batch independent sibling pairs
+// through this routine, so that a wider permutation can be plugged in, without
+// touching tree building logic.
+template<size_t n, variant v, size_t lanes>
+static inline constexpr void
+h_batch(std::span<const uint8_t, n> pk_seed,
+        std::span<const sphincs_plus_adrs::adrs_t, lanes> adrs,
+        std::span<const uint8_t, lanes * 2 * n> msgs,
+        std::span<uint8_t, lanes * n> digs)
+{
+  t_l_batch<n, 2, v, lanes>(pk_seed, adrs, msgs, digs);
+}
+
 }
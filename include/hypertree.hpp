@@ -1,4 +1,6 @@
 #pragma once
+#include "node_cache.hpp"
+#include "tracing.hpp"
 #include "xmss.hpp"
 
 // HT: The Hypertree, used in SPHINCS+
@@ -11,7 +13,10 @@ namespace sphincs_plus_ht {
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
 static inline void
-pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed, std::span<uint8_t, n> pkey)
+pkgen(std::span<const uint8_t, n> sk_seed,
+      std::span<const uint8_t, n> pk_seed,
+      std::span<uint8_t, n> pkey,
+      sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
   requires(sphincs_plus_params::check_ht_height_and_layer(h, d))
 {
   sphincs_plus_adrs::adrs_t adrs{};
@@ -19,7 +24,7 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
   adrs.set_layer_address(d - 1u);
   adrs.set_tree_address(0ul);
 
-  sphincs_plus_xmss::pkgen<h / d, n, w, v>(sk_seed, pk_seed, adrs, pkey);
+  sphincs_plus_xmss::pkgen<h / d, n, w, v>(sk_seed, pk_seed, adrs, pkey, ws);
 }
 
 // Computes (h + d * len) * n -bytes HyperTree signature, consisting of d
@@ -31,6 +36,9 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
 // For understanding HyperTree signature structure, I suggest you look at figure
 // 11 and read section 4.2.3 of SPHINCS+ specification.
 //
+// Nodes of each XMSS tree are computed in caller-supplied workspace, when
+// supplied, else on stack, see `sphincs_plus_xmss::sign_and_root`.
+//
 // Find the specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
@@ -40,7 +48,8 @@ sign(std::span<const uint8_t, n> msg,
      std::span<const uint8_t, n> pk_seed,
      const uint64_t idx_tree,
      const uint32_t idx_leaf,
-     std::span<uint8_t, (h + d * sphincs_plus_utils::compute_wots_len<n, w>()) * n> sig)
+     std::span<uint8_t, (h + d * sphincs_plus_utils::compute_wots_len<n, w>()) * n> sig,
+     sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
   requires(sphincs_plus_params::check_ht_height_and_layer(h, d))
 {
   constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
@@ -50,13 +59,23 @@ sign(std::span<const uint8_t, n> msg,
 
   sphincs_plus_adrs::adrs_t adrs{};
   std::array<uint8_t, n> rt{};
+  std::array<uint8_t, n> t{};
   auto xmss_sig = sig.template subspan<0, xmss_sig_len>();
 
+  namespace tracing = sphincs_plus_tracing;
+  constexpr uint64_t params = tracing::params<n, h, d, 0u, 0u, w, v>();
+  tracing::begin(tracing::phase_t::ht_sign, 0u, params);
+
   adrs.set_layer_address(0u);
   adrs.set_tree_address(idx_tree);
 
-  sphincs_plus_xmss::sign<h_, n, w, v>(msg, sk_seed, idx_leaf, pk_seed, adrs, xmss_sig);
-  sphincs_plus_xmss::pk_from_sig<h_, n, w, v>(idx_leaf, xmss_sig, msg, pk_seed, adrs, rt);
+  // XMSS signature and root of XMSS tree are computed in a single pass over
+  // the tree, instead of `xmss::sign` followed by `xmss::pk_from_sig`. Both
+  // make same # -of F, H and PRF calls, so it only saves the base-w pass over
+  // message, which `pk_from_sig` would redo.
+  tracing::begin(tracing::phase_t::ht_layer, 0u, params);
+  sphincs_plus_xmss::sign_and_root<h_, n, w, v>(msg, sk_seed, idx_leaf, pk_seed, adrs, xmss_sig, rt, ws);
+  tracing::end(tracing::phase_t::ht_layer, 0u, params);
 
   uint64_t itree = idx_tree;
   uint32_t ileaf = idx_leaf;
@@ -71,15 +90,14 @@ sign(std::span<const uint8_t, n> msg,
     adrs.set_layer_address(j);
     adrs.set_tree_address(itree);
 
-    sphincs_plus_xmss::sign<h_, n, w, v>(rt, sk_seed, ileaf, pk_seed, adrs, _sig);
-
-    if (j < (d - 1u)) {
-      std::array<uint8_t, n> t{};
+    tracing::begin(tracing::phase_t::ht_layer, j, params);
+    sphincs_plus_xmss::sign_and_root<h_, n, w, v>(rt, sk_seed, ileaf, pk_seed, adrs, _sig, t, ws);
+    tracing::end(tracing::phase_t::ht_layer, j, params);
 
-      sphincs_plus_xmss::pk_from_sig<h_, n, w, v>(ileaf, _sig, rt, pk_seed, adrs, t);
-      std::copy(t.begin(), t.end(), rt.begin());
-    }
+    std::copy(t.begin(), t.end(), rt.begin());
   }
+
+  tracing::end(tracing::phase_t::ht_sign, 0u, params);
 }
 
 // Verifies a hypertree signature of (h + d * len) * n -bytes on a message of
@@ -90,6 +108,12 @@ sign(std::span<const uint8_t, n> msg,
 //
 // This routine returns truth value in case of successful hypertree signature
 // verification, otherwise it returns false.
+//
+// Optionally, one may pass a verified-node cache, bound to same public key, in
+// which case verification stops early, as soon as a recomputed XMSS tree root
+// matches an already authenticated one, while roots recomputed during a
+// successful verification are remembered. See include/node_cache.hpp. A cache
+// bound to some other public key is simply ignored.
 template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
 static inline bool
 verify(std::span<const uint8_t, n> msg,
@@ -97,7 +121,8 @@ verify(std::span<const uint8_t, n> msg,
        std::span<const uint8_t, n> pk_seed,
        const uint64_t idx_tree,
        const uint32_t idx_leaf,
-       std::span<const uint8_t, n> pkey)
+       std::span<const uint8_t, n> pkey,
+       sphincs_plus_node_cache::node_cache_t<h, d, n, w, v>* const cache = nullptr)
   requires(sphincs_plus_params::check_ht_height_and_layer(h, d))
 {
   constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
@@ -112,12 +137,37 @@ verify(std::span<const uint8_t, n> msg,
   adrs.set_layer_address(0u);
   adrs.set_tree_address(idx_tree);
 
+  const bool cached = (cache != nullptr) && cache->is_bound_to(pk_seed, pkey);
+  std::array<uint64_t, d> trees{};
+  std::array<std::array<uint8_t, n>, d> roots{};
+
+  // Checks whether n -bytes root of XMSS tree, at layer j, is already authenticated, in which case all roots recomputed
+  // below layer j also get authenticated. Otherwise root is kept around, to be remembered after successful verification.
+  auto lookup = [&](const uint32_t j, const uint64_t t) {
+    if (cache->contains(j, t, nd)) {
+      for (uint32_t i = 0; i < j; i++) {
+        cache->insert(i, trees[i], roots[i]);
+      }
+
+      cache->record_hit(j);
+      return true;
+    }
+
+    trees[j] = t;
+    roots[j] = nd;
+    return false;
+  };
+
   auto xmss_sig = sig.template subspan<0, xmss_sig_len>();
   sphincs_plus_xmss::pk_from_sig<h_, n, w, v>(idx_leaf, xmss_sig, msg, pk_seed, adrs, nd);
 
   uint64_t itree = idx_tree;
   uint32_t ileaf = idx_leaf;
 
+  if (cached && lookup(0u, itree)) {
+    return true;
+  }
+
   for (uint32_t j = 1; j < d; j++) {
     const size_t off = static_cast<size_t>(j) * xmss_sig_len;
     auto _sig = std::span<const uint8_t, xmss_sig_len>(sig.subspan(off, xmss_sig_len));
@@ -130,6 +180,10 @@ verify(std::span<const uint8_t, n> msg,
 
     sphincs_plus_xmss::pk_from_sig<h_, n, w, v>(ileaf, _sig, nd, pk_seed, adrs, tmp);
     std::copy(tmp.begin(), tmp.end(), nd.begin());
+
+    if (cached && lookup(j, itree)) {
+      return true;
+    }
   }
 
   bool flg = false;
@@ -137,6 +191,16 @@ verify(std::span<const uint8_t, n> msg,
     flg |= static_cast<bool>(nd[i] ^ pkey[i]);
   }
 
+  if (cached) {
+    if (!flg) {
+      for (uint32_t i = 0; i + 1 < d; i++) {
+        cache->insert(i, trees[i], roots[i]);
+      }
+    }
+
+    cache->record_miss();
+  }
+
   return !flg;
 }
 
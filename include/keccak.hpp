@@ -0,0 +1,260 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Scalar Keccak-f[1600] permutation and single-block SHAKE256, backing tweakable hash functions of SPHINCS+-SHAKE
+namespace sphincs_plus_keccak {
+
+// # -of rounds of Keccak-f[1600] permutation
+constexpr size_t ROUNDS = 24;
+
+// # -of 64 -bit lanes in Keccak-f[1600] state
+constexpr size_t LANE_CNT = 25;
+
+// Rate of SHAKE256 sponge, in bytes
+constexpr size_t SHAKE256_RATE = 136;
+
+// # -of independent Keccak-f[1600] permutations, interleaved by batched tweakable hash function calls. Interleaving two
+// states brings cost per permutation down, while a third one only adds register pressure.
+constexpr size_t WAYS = 2;
+
+// Keccak-f[1600] state, with lane (x, y) living at index x + 5 * y
+using state_t = std::array<uint64_t, LANE_CNT>;
+
+// When BMI1 is available, `~b & c` is a single `andn` instruction, so chi step doesn't gain anything from lane
+// complementing. Otherwise lane complementing is used, by default, to cut down # -of NOT operations.
+#if defined __BMI__
+constexpr bool LANE_COMPLEMENTING = false;
+#else
+constexpr bool LANE_COMPLEMENTING = true;
+#endif
+
+// Round constants, applied in iota step, see section 3.2.5 of SHA3 specification
+// https://dx.doi.org/10.6028/NIST.FIPS.202
+constexpr std::array<uint64_t, ROUNDS> RC = {
+  0x0000000000000001ul, 0x0000000000008082ul, 0x800000000000808aul, 0x8000000080008000ul, 0x000000000000808bul, 0x0000000080000001ul,
+  0x8000000080008081ul, 0x8000000000008009ul, 0x000000000000008aul, 0x0000000000000088ul, 0x0000000080008009ul, 0x000000008000000aul,
+  0x000000008000808bul, 0x800000000000008bul, 0x8000000000008089ul, 0x8000000000008003ul, 0x8000000000008002ul, 0x8000000000000080ul,
+  0x000000000000800aul, 0x800000008000000aul, 0x8000000080008081ul, 0x8000000000008080ul, 0x0000000080000001ul, 0x8000000080008008ul,
+};
+
+// Fused rho and pi steps, s.t. i -th lane, input to chi step, is i -th rotation of SRC[i] -th lane of state, after
+// theta step, see sections 3.2.2, 3.2.3 of SHA3 specification.
+constexpr std::array<size_t, LANE_CNT> SRC = { 0, 6, 12, 18, 24, 3, 9, 10, 16, 22, 1, 7, 13, 19, 20, 4, 5, 11, 17, 23, 2, 8, 14, 15, 21 };
+constexpr std::array<int, LANE_CNT> ROT = { 0, 44, 43, 21, 14, 28, 20, 3, 45, 61, 1, 6, 25, 8, 18, 27, 36, 10, 15, 56, 62, 55, 39, 41, 2 };
+
+// Lanes kept complemented between rounds, when lane complementing is enabled, following "Keccak implementation
+// overview", section 2.2, https://keccak.team/files/Keccak-implementation-3.2.pdf
+constexpr std::array<size_t, 6> COMPLEMENTED = { 1, 2, 8, 12, 17, 20 };
+
+// Chi step computes lane x of a row as `a ^ (~b & c)`, where a, b, c are lanes x, x+1, x+2 of the row. When some of
+// input and output lanes are kept complemented, same result is obtained by `a' ^ (b' op c')` s.t. op is either AND or
+// OR and a', b', c' are either stored lanes or their complements.
+struct chi_t
+{
+  bool not_a = false;
+  bool not_b = false;
+  bool not_c = false;
+  bool use_or = false;
+};
+
+// Chi step, without lane complementing
+constexpr std::array<chi_t, LANE_CNT> CHI = []() {
+  std::array<chi_t, LANE_CNT> chi{};
+  chi.fill({ false, true, false, false });
+  return chi;
+}();
+
+// Chi step, with lanes listed in `COMPLEMENTED` kept complemented, both at input of theta step and output of chi step.
+// Each row of it requires a single NOT operation, in place of 5.
+constexpr std::array<chi_t, LANE_CNT> CHI_COMPLEMENTED = { {
+  // Row 0
+  { false, false, false, true },
+  { false, true, false, true },
+  { false, false, false, false },
+  { false, false, false, true },
+  { false, false, false, false },
+  // Row 1
+  { false, false, false, true },
+  { false, false, false, false },
+  { false, false, true, true },
+  { false, false, false, true },
+  { false, false, false, false },
+  // Row 2
+  { false, false, false, true },
+  { false, false, false, false },
+  { false, true, false, false },
+  { true, false, false, true },
+  { false, false, false, false },
+  // Row 3
+  { false, false, false, false },
+  { false, false, false, true },
+  { false, true, false, true },
+  { true, false, false, false },
+  { false, false, false, true },
+  // Row 4
+  { false, true, false, false },
+  { true, false, false, true },
+  { false, false, false, false },
+  { false, false, false, true },
+  { false, false, false, false },
+} };
+
+// Lanes rotated by distinct offsets don't pack well into vector registers, so GCC's SLP vectorizer, enabled at -O3,
+// only slows scalar permutation down, by shuffling lanes in and out of vector registers.
+#if defined __GNUG__ && !defined __clang__
+#pragma GCC push_options
+#pragma GCC optimize("no-tree-slp-vectorize")
+#endif
+
+// Calls `fn` with std::integral_constant<size_t, i>, for i = 0, 1, ..., N - 1, so that loop body is replicated N times,
+// at compile-time, with constant index, irrespective of unrolling heuristics of compiler.
+template<size_t N, typename fn_t>
+static inline void
+unroll(fn_t&& fn)
+{
+  [&]<size_t... i>(std::index_sequence<i...>) { (fn(std::integral_constant<size_t, i>{}), ...); }(std::make_index_sequence<N>{});
+}
+
+// Complements lanes listed in `COMPLEMENTED`, of each of `ways` -many states.
+template<size_t ways>
+static inline void
+complement(std::array<state_t, ways>& st)
+{
+  unroll<ways>([&](auto i) {
+    for (const size_t j : COMPLEMENTED) {
+      st[i][j] = ~st[i][j];
+    }
+  });
+}
+
+// Keccak-f[1600] round, applied on `ways` -many independent states, reading from A and writing to E. Each step is
+// computed for all states, before moving to next step, so that independent instructions are available for filling
+// pipelines of a superscalar core.
+//
+// See section 3.3 of SHA3 specification https://dx.doi.org/10.6028/NIST.FIPS.202
+template<size_t ways, bool lane_complementing>
+static inline void
+round(const std::array<state_t, ways>& A, std::array<state_t, ways>& E, const uint64_t rc)
+{
+  constexpr auto chi = lane_complementing ? CHI_COMPLEMENTED : CHI;
+
+  std::array<std::array<uint64_t, 5>, ways> C{};
+  std::array<std::array<uint64_t, 5>, ways> D{};
+
+  // Theta step
+  unroll<ways>([&](auto i) {
+    unroll<5>([&](auto x) { C[i][x] = A[i][x] ^ A[i][x + 5] ^ A[i][x + 10] ^ A[i][x + 15] ^ A[i][x + 20]; });
+    unroll<5>([&](auto x) { D[i][x] = C[i][(x + 4) % 5] ^ std::rotl(C[i][(x + 1) % 5], 1); });
+  });
+
+  // Rho, pi and chi steps, one row at a time
+  unroll<5>([&](auto y) {
+    unroll<ways>([&](auto i) {
+      std::array<uint64_t, 5> B{};
+
+      unroll<5>([&](auto x) {
+        constexpr size_t j = 5 * y + x;
+        B[x] = std::rotl(A[i][SRC[j]] ^ D[i][SRC[j] % 5], ROT[j]);
+      });
+
+      unroll<5>([&](auto x) {
+        constexpr size_t j = 5 * y + x;
+
+        const uint64_t a = chi[j].not_a ? ~B[x] : B[x];
+        const uint64_t b = chi[j].not_b ? ~B[(x + 1) % 5] : B[(x + 1) % 5];
+        const uint64_t c = chi[j].not_c ? ~B[(x + 2) % 5] : B[(x + 2) % 5];
+
+        if constexpr (chi[j].use_or) {
+          E[i][j] = a ^ (b | c);
+        } else {
+          E[i][j] = a ^ (b & c);
+        }
+      });
+    });
+  });
+
+  // Iota step
+  unroll<ways>([&](auto i) { E[i][0] ^= rc; });
+}
+
+// Applies Keccak-f[1600] permutation on `ways` -many independent states, interleaving their rounds. When `ways` > 1,
+// each round has more independent instructions to offer than a single state does, which helps keep execution ports of
+// a superscalar core busy. All rounds are unrolled, using two alternating copies of states.
+template<size_t ways = 1, bool lane_complementing = LANE_COMPLEMENTING>
+static inline void
+permute(std::array<state_t, ways>& st)
+  requires(ways > 0)
+{
+  std::array<state_t, ways> E;
+
+  if constexpr (lane_complementing) {
+    complement(st);
+  }
+
+  unroll<ROUNDS / 2>([&](auto r) {
+    round<ways, lane_complementing>(st, E, RC[2 * r]);
+    round<ways, lane_complementing>(E, st, RC[2 * r + 1]);
+  });
+
+  if constexpr (lane_complementing) {
+    complement(st);
+  }
+}
+
+#if defined __GNUG__ && !defined __clang__
+#pragma GCC pop_options
+#endif
+
+// Given `ways` -many ilen -bytes messages, laid out one after another, this routine computes olen -bytes SHAKE256 digest
+// of each of them, when both message and digest fit in a single block of SHAKE256, so that only one Keccak-f[1600]
+// permutation is required per message. Permutations of all messages are interleaved. Digest of i -th message is
+// written to i -th olen -bytes wide segment of `digs`.
+//
+// Tweakable hash functions and PRF of SPHINCS+ hash at max 32 + 32 + 2*32 -bytes, producing at max 2*32 -bytes, so they
+// can be computed this way, without paying for a generic incremental sponge.
+template<size_t ilen, size_t olen, size_t ways = 1>
+static inline void
+shake256(std::span<const uint8_t, ways * ilen> msgs, std::span<uint8_t, ways * olen> digs)
+  requires((ilen < SHAKE256_RATE) && (olen <= SHAKE256_RATE))
+{
+  std::array<state_t, ways> st{};
+
+  for (size_t i = 0; i < ways; i++) {
+    auto msg = msgs.subspan(i * ilen, ilen);
+
+    if constexpr (std::endian::native == std::endian::little) {
+      std::memcpy(st[i].data(), msg.data(), ilen);
+    } else {
+      for (size_t j = 0; j < ilen; j++) {
+        st[i][j >> 3] |= static_cast<uint64_t>(msg[j]) << ((j & 7) << 3);
+      }
+    }
+
+    // Padding, see section 6.2 and appendix B.2 of SHA3 specification
+    st[i][ilen >> 3] ^= 0x1ful << ((ilen & 7) << 3);
+    st[i][(SHAKE256_RATE - 1) >> 3] ^= 0x80ul << (((SHAKE256_RATE - 1) & 7) << 3);
+  }
+
+  permute<ways>(st);
+
+  for (size_t i = 0; i < ways; i++) {
+    auto dig = digs.subspan(i * olen, olen);
+
+    if constexpr (std::endian::native == std::endian::little) {
+      std::memcpy(dig.data(), st[i].data(), olen);
+    } else {
+      for (size_t j = 0; j < olen; j++) {
+        dig[j] = static_cast<uint8_t>(st[i][j >> 3] >> ((j & 7) << 3));
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include "shake256.hpp"
+#include "sphincs+.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+// Binary Merkle Tree over arbitrary byte strings, built using SHAKE256, for authenticating many messages/ chunks with a
+// single SPHINCS+ signature
+namespace sphincs_plus_merkle {
+
+// Domain separation prefixes, for hashing leaves and internal nodes of Merkle Tree, so that a leaf can never be
+// interpreted as an internal node and vice versa.
+constexpr uint8_t LEAF_PREFIX = 0x00;
+constexpr uint8_t NODE_PREFIX = 0x01;
+
+// Compile-time compute byte length of Merkle Tree nodes, for SPHINCS+ instance with security parameter n.
+template<size_t n>
+static inline constexpr size_t
+get_node_len()
+{
+  return n + n;
+}
+
+// Compile-time evaluable routine, computing height of Merkle Tree, with `leaf_cnt` (>0) -many leaves, after padding
+// # -of leaves to next power of 2.
+static inline constexpr uint32_t
+compute_depth(const size_t leaf_cnt)
+{
+  return static_cast<uint32_t>(std::bit_width(std::max<size_t>(leaf_cnt, 1) - 1));
+}
+
+// Compile-time evaluable routine, computing total # -of nodes in a Merkle Tree of height `depth`.
+static inline constexpr size_t
+compute_node_cnt(const uint32_t depth)
+{
+  return (2ul << depth) - 1ul;
+}
+
+// Given arbitrary length message, this routine computes m -bytes Merkle Tree leaf, using SHAKE256 s.t. the message is
+// prefixed with leaf domain separator.
+template<size_t m>
+static inline void
+hash_leaf(std::span<const uint8_t> msg, std::span<uint8_t, m> leaf)
+{
+  constexpr std::array<uint8_t, 1> prefix{ LEAF_PREFIX };
+
+  shake256::shake256_t hasher;
+
+  hasher.absorb(prefix);
+  hasher.absorb(msg);
+  hasher.finalize();
+  hasher.squeeze(leaf);
+}
+
+// Given two m -bytes sibling nodes, this routine computes m -bytes parent node, using SHAKE256 s.t. children are
+// prefixed with internal node domain separator.
+template<size_t m>
+static inline void
+hash_node(std::span<const uint8_t, m> lnode, std::span<const uint8_t, m> rnode, std::span<uint8_t, m> parent)
+{
+  std::array<uint8_t, 1 + m + m> tmp{};
+  auto _tmp = std::span(tmp);
+
+  _tmp[0] = NODE_PREFIX;
+  std::copy(lnode.begin(), lnode.end(), _tmp.template subspan<1, m>().begin());
+  std::copy(rnode.begin(), rnode.end(), _tmp.template subspan<1 + m, m>().begin());
+
+  shake256::shake256_t hasher;
+
+  hasher.absorb(tmp);
+  hasher.finalize();
+  hasher.squeeze(parent);
+}
+
+// Byte offset of first node of level `lvl` ( = 0 for leaves ), in flat node array of a Merkle Tree of height `depth`,
+// which stores all nodes level by level, starting with leaves and ending with root.
+template<size_t m>
+static inline constexpr size_t
+level_offset(const uint32_t depth, const uint32_t lvl)
+{
+  return (compute_node_cnt(depth) - compute_node_cnt(depth - lvl)) * m;
+}
+
+// Given flat node array of a Merkle Tree of height `depth`, this routine computes parent nodes at index [frm, to) of
+// level `lvl + 1`, by hashing pairs of children from level `lvl`, which must already be computed.
+template<size_t m>
+static inline void
+hash_level(std::span<uint8_t> nodes, const uint32_t depth, const uint32_t lvl, const size_t frm, const size_t to)
+{
+  const size_t coff = level_offset<m>(depth, lvl);
+  const size_t poff = level_offset<m>(depth, lvl + 1);
+
+  for (size_t i = frm; i < to; i++) {
+    auto lnode = std::span<const uint8_t, m>(nodes.subspan(coff + (2 * i) * m, m));
+    auto rnode = std::span<const uint8_t, m>(nodes.subspan(coff + (2 * i + 1) * m, m));
+    auto parent = std::span<uint8_t, m>(nodes.subspan(poff + i * m, m));
+
+    hash_node<m>(lnode, rnode, parent);
+  }
+}
+
+// Given `leaf_cnt` -many m -bytes leaves, already placed at beginning of flat node array, of a Merkle Tree of height
+// `depth` ( see `compute_depth` ), this routine pads leaf level with empty ( i.e. all zero ) nodes and computes all
+// internal nodes, level by level, s.t. last m -bytes of node array holds the root.
+//
+// Node array is expected to be `compute_node_cnt(depth) * m` -bytes wide.
+template<size_t m>
+static inline void
+build_tree(const size_t leaf_cnt, const uint32_t depth, std::span<uint8_t> nodes)
+{
+  assert(nodes.size() == compute_node_cnt(depth) * m);
+  assert(leaf_cnt <= (1ul << depth));
+
+  auto pad = nodes.subspan(leaf_cnt * m, ((1ul << depth) - leaf_cnt) * m);
+  std::fill(pad.begin(), pad.end(), 0x00);
+
+  for (uint32_t lvl = 0; lvl < depth; lvl++) {
+    hash_level<m>(nodes, depth, lvl, 0, 1ul << (depth - lvl - 1));
+  }
+}
+
+// Given flat node array of a Merkle Tree of height `depth`, this routine copies `depth` -many m -bytes sibling nodes,
+// on path from leaf at index `idx` to root, to authentication path `path`, starting with sibling of the leaf.
+template<size_t m>
+static inline void
+auth_path(std::span<const uint8_t> nodes, const uint32_t depth, const size_t idx, std::span<uint8_t> path)
+{
+  assert(path.size() == static_cast<size_t>(depth) * m);
+
+  for (uint32_t lvl = 0; lvl < depth; lvl++) {
+    const size_t sibling = (idx >> lvl) ^ 1ul;
+    auto node = nodes.subspan(level_offset<m>(depth, lvl) + sibling * m, m);
+
+    std::copy(node.begin(), node.end(), path.subspan(lvl * m, m).begin());
+  }
+}
+
+// Given m -bytes leaf at index `idx` and its authentication path, comprising of m -bytes sibling nodes, this routine
+// recomputes m -bytes root of the Merkle Tree, of height = path.size() / m.
+template<size_t m>
+static inline void
+root_from_path(std::span<const uint8_t, m> leaf, const size_t idx, std::span<const uint8_t> path, std::span<uint8_t, m> root)
+{
+  const uint32_t depth = static_cast<uint32_t>(path.size() / m);
+
+  std::array<uint8_t, m> node{};
+  std::array<uint8_t, m> tmp{};
+  std::copy(leaf.begin(), leaf.end(), node.begin());
+
+  for (uint32_t lvl = 0; lvl < depth; lvl++) {
+    auto sibling = std::span<const uint8_t, m>(path.subspan(lvl * m, m));
+
+    if (((idx >> lvl) & 1ul) == 0ul) {
+      hash_node<m>(node, sibling, tmp);
+    } else {
+      hash_node<m>(sibling, node, tmp);
+    }
+
+    node = tmp;
+  }
+
+  std::copy(node.begin(), node.end(), root.begin());
+}
+
+// Bounded set of authenticated Merkle Tree roots ( each of len -bytes, possibly encoded along with some metadata ),
+// which are remembered after successfully verifying a SPHINCS+ signature over them, so that subsequent inclusion
+// proofs, against same root, can be verified without verifying the SPHINCS+ signature again.
+//
+// It's safe to be shared among threads. It keeps at max `capacity` -many roots, evicting the oldest one, when full.
+template<size_t len>
+struct root_cache_t
+{
+private:
+  std::vector<std::array<uint8_t, len>> roots;
+  size_t next = 0;
+  mutable std::mutex lock;
+
+public:
+  // Constructs an empty cache, which can remember at max `capacity` (>0) -many authenticated roots.
+  inline explicit root_cache_t(const size_t capacity) { roots.reserve(std::max<size_t>(capacity, 1)); }
+
+  // Checks whether encoded root is already authenticated.
+  inline bool contains(std::span<const uint8_t, len> root) const
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    return std::find_if(roots.begin(), roots.end(), [&](const auto& r) { return std::equal(r.begin(), r.end(), root.begin()); }) != roots.end();
+  }
+
+  // Remembers authenticated encoded root, evicting the oldest one, if required.
+  inline void insert(std::span<const uint8_t, len> root)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (std::find_if(roots.begin(), roots.end(), [&](const auto& r) { return std::equal(r.begin(), r.end(), root.begin()); }) != roots.end()) {
+      return;
+    }
+
+    std::array<uint8_t, len> tmp{};
+    std::copy(root.begin(), root.end(), tmp.begin());
+
+    if (roots.size() < roots.capacity()) {
+      roots.push_back(tmp);
+    } else {
+      roots[next] = tmp;
+      next = (next + 1) % roots.size();
+    }
+  }
+};
+
+// Verifier of SPHINCS+ signatures over encoded Merkle Tree roots ( each of len -bytes ), bound to a SPHINCS+ public
+// key, which remembers last few successfully verified roots, so that SPHINCS+ signature over an already authenticated
+// root isn't verified again. It also counts how many verifications were served from remembered roots.
+//
+// Verifier is safe to be shared among threads. It keeps at max `capacity` -many roots, evicting the oldest one, when
+// full.
+template<size_t len, size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+struct root_verifier_t
+{
+private:
+  static constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  static constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::array<uint8_t, pklen> pkey{};
+  root_cache_t<len> roots;
+
+  std::atomic<uint64_t> hits = 0;
+  std::atomic<uint64_t> misses = 0;
+
+public:
+  // Constructs a root verifier for given 2*n -bytes SPHINCS+ public key, remembering at max `capacity` (>0) -many
+  // authenticated roots.
+  inline explicit root_verifier_t(std::span<const uint8_t, pklen> pkey, const size_t capacity)
+    : roots(capacity)
+  {
+    std::copy(pkey.begin(), pkey.end(), this->pkey.begin());
+  }
+
+  // Verifies SPHINCS+ signature over encoded root, returning truth value in case of successful verification. SPHINCS+
+  // signature is verified only if the root is not yet authenticated.
+  inline bool verify(std::span<const uint8_t, len> root, std::span<const uint8_t, siglen> sig)
+  {
+    if (roots.contains(root)) {
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+
+    const bool flg = sphincs_plus::verify<n, h, d, a, k, w, v>(root, sig, pkey);
+    if (flg) {
+      roots.insert(root);
+    }
+
+    return flg;
+  }
+
+  // Returns # -of verifications which didn't require verifying SPHINCS+ signature.
+  inline uint64_t get_hits() const { return hits.load(std::memory_order_relaxed); }
+
+  // Returns # -of verifications which required verifying SPHINCS+ signature.
+  inline uint64_t get_misses() const { return misses.load(std::memory_order_relaxed); }
+};
+
+}
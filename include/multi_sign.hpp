@@ -0,0 +1,199 @@
+#pragma once
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Locality-aware signing of many messages, under same SPHINCS+ secret key, producing regular SPHINCS+ signatures
+namespace sphincs_plus_multi {
+
+// Signs many messages, using same 4*n -bytes SPHINCS+ secret key, producing one regular SPHINCS+ signature per message,
+// which is byte-identical to what `sphincs_plus::sign` produces for that message. Signature of i -th message is written
+// to i -th `get_sphincs_sig_len()` -bytes wide segment of `sigs`.
+//
+// Every message of the batch is signed using the single XMSS tree of layer d-1, while layer d-2 only has 2^(h/d) -many
+// XMSS trees, so upper layer XMSS trees are shared by many messages of a batch. This routine first computes randomness,
+// message digest, FORS signature and tree/ leaf indices of every message, then processes HyperTree layer by layer,
+// grouping messages by the XMSS tree they use on that layer. Each distinct XMSS tree, shared by more than one message,
+// is built once, as a whole, producing WOTS+ signatures of all messages of the group, while computing respective
+// leaves, and authentication paths are then copied from it. As root of the tree is already computed, XMSS public key
+// doesn't need to be recomputed from signature. An XMSS tree used by a single message is processed same as
+// `sphincs_plus_ht::sign` does.
+//
+// Randomized signing works same as `sphincs_plus::sign`, when n -bytes randomness is supplied for each message, in which
+// case `rand_bytes` is expected to be msgs.size() * n -bytes wide. Otherwise, `rand_bytes` should be empty.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize = false>
+static inline void
+sign(std::span<const std::span<const uint8_t>> msgs,
+     std::span<const uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
+     std::span<const uint8_t> rand_bytes,
+     std::span<uint8_t> sigs)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  constexpr size_t md_len = static_cast<size_t>((k * a + 7) / 8);
+  constexpr size_t itree_len = static_cast<size_t>((h - (h / d) + 7) / 8);
+  constexpr size_t ileaf_len = static_cast<size_t>(((h / d) + 7) / 8);
+  constexpr size_t m = md_len + itree_len + ileaf_len;
+
+  constexpr size_t fors_sl = sphincs_plus_utils::compute_fors_sig_len<n, a, k>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  constexpr uint32_t xh = h / d;
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t xmss_sig_len = (static_cast<size_t>(xh) + len) * n;
+
+  constexpr uint32_t h_ = h - (h / d);
+  constexpr bool flg = h_ == 64u;
+
+  constexpr uint64_t mask0 = (1ul << (h_ - 1u * flg)) + (1ul << 63) * flg - 1ul;
+  constexpr uint32_t mask1 = (1u << (h / d)) - 1ul;
+
+  const size_t msg_cnt = msgs.size();
+
+  assert(sigs.size() == msg_cnt * siglen);
+  assert(rand_bytes.size() == msg_cnt * n * randomize);
+
+  auto sk_seed = skey.template subspan<0, n>();
+  auto sk_prf = skey.template subspan<n, n>();
+  auto pk_seed = skey.template subspan<2 * n, n>();
+  auto pk_root = skey.template subspan<3 * n, n>();
+
+  // Tree index, leaf index and n -bytes message, to be signed on current HyperTree layer, for each message of the batch
+  std::vector<uint64_t> itrees(msg_cnt, 0);
+  std::vector<uint32_t> ileafs(msg_cnt, 0);
+  std::vector<uint8_t> roots(msg_cnt * n, 0);
+
+  auto _roots = std::span(roots);
+
+  for (size_t i = 0; i < msg_cnt; i++) {
+    auto sig = std::span<uint8_t, siglen>(sigs.subspan(i * siglen, siglen));
+
+    auto _sig0 = sig.template subspan<0, n>();       // Randomness portion
+    auto _sig1 = sig.template subspan<n, fors_sl>(); // FORS signature portion
+
+    std::array<uint8_t, n> opt{};
+    std::array<uint8_t, m> dig{};
+    auto _dig = std::span(dig);
+
+    if constexpr (randomize) {
+      auto _rand_bytes = rand_bytes.subspan(i * n, n);
+      std::copy(_rand_bytes.begin(), _rand_bytes.end(), opt.begin());
+    } else {
+      std::copy(pk_seed.begin(), pk_seed.end(), opt.begin());
+    }
+
+    sphincs_plus_hashing::prf_msg<n>(sk_prf, opt, msgs[i], _sig0);
+    sphincs_plus_hashing::h_msg<n, m>(_sig0, pk_seed, pk_root, msgs[i], _dig);
+
+    auto md = _dig.template subspan<0, md_len>();
+    auto tmp_itree = _dig.template subspan<md_len, itree_len>();
+    auto tmp_ileaf = _dig.template subspan<md_len + itree_len, ileaf_len>();
+
+    uint64_t itree = 0ul;
+    for (size_t j = 0; j < itree_len; j++) {
+      itree |= static_cast<uint64_t>(tmp_itree[j]) << ((itree_len - 1 - j) << 3);
+    }
+
+    uint32_t ileaf = 0u;
+    for (size_t j = 0; j < ileaf_len; j++) {
+      ileaf |= static_cast<uint32_t>(tmp_ileaf[j]) << ((ileaf_len - 1 - j) << 3);
+    }
+
+    itrees[i] = itree & mask0;
+    ileafs[i] = ileaf & mask1;
+
+    sphincs_plus_adrs::fors_tree_t adrs{};
+
+    adrs.set_layer_address(0u);
+    adrs.set_tree_address(itrees[i]);
+    adrs.set_type(sphincs_plus_adrs::type_t::FORS_TREE);
+    adrs.set_keypair_address(ileafs[i]);
+
+    sphincs_plus_fors::sign<n, a, k, v>(md, sk_seed, pk_seed, adrs, _sig1);
+    sphincs_plus_fors::pk_from_sig<n, a, k, v>(_sig1, md, pk_seed, adrs, std::span<uint8_t, n>(_roots.subspan(i * n, n)));
+  }
+
+  std::vector<size_t> order(msg_cnt, 0);
+  std::vector<sphincs_plus_xmss::leaf_sig_t<n, w>> reqs;
+  std::vector<uint8_t> nodes(sphincs_plus_xmss::get_tree_len<xh, n>(), 0);
+
+  auto _nodes = std::span<uint8_t, sphincs_plus_xmss::get_tree_len<xh, n>()>(nodes);
+  auto root = _nodes.template last<n>();
+
+  for (uint32_t j = 0; j < d; j++) {
+    if (j > 0) {
+      for (size_t i = 0; i < msg_cnt; i++) {
+        ileafs[i] = static_cast<uint32_t>(itrees[i]) & mask1;
+        itrees[i] = itrees[i] >> xh;
+      }
+    }
+
+    // Group messages by XMSS tree they use on this layer, ordered by leaf index within each group
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const size_t x, const size_t y) {
+      return (itrees[x] < itrees[y]) || ((itrees[x] == itrees[y]) && (ileafs[x] < ileafs[y]));
+    });
+
+    sphincs_plus_adrs::adrs_t adrs{};
+    adrs.set_layer_address(j);
+
+    size_t frm = 0;
+    while (frm < msg_cnt) {
+      const uint64_t itree = itrees[order[frm]];
+
+      size_t to = frm + 1;
+      while ((to < msg_cnt) && (itrees[order[to]] == itree)) {
+        to++;
+      }
+
+      adrs.set_tree_address(itree);
+
+      // XMSS tree used by a single message is cheaper to be signed from, without keeping it as a whole
+      if ((to - frm) == 1) {
+        const size_t idx = order[frm];
+        const size_t off = idx * siglen + n + fors_sl + static_cast<size_t>(j) * xmss_sig_len;
+
+        auto msg = std::span<uint8_t, n>(_roots.subspan(idx * n, n));
+        auto sig = std::span<uint8_t, xmss_sig_len>(sigs.subspan(off, xmss_sig_len));
+
+        std::array<uint8_t, n> tmp{};
+
+        sphincs_plus_xmss::sign_and_root<xh, n, w, v>(msg, sk_seed, ileafs[idx], pk_seed, adrs, sig, tmp);
+        std::copy(tmp.begin(), tmp.end(), msg.begin());
+
+        frm = to;
+        continue;
+      }
+
+      // WOTS+ signatures of all messages of the group are produced while building the tree
+      reqs.clear();
+      for (size_t i = frm; i < to; i++) {
+        const size_t idx = order[i];
+        const size_t off = idx * siglen + n + fors_sl + static_cast<size_t>(j) * xmss_sig_len;
+
+        reqs.push_back({
+          ileafs[idx],
+          std::span<const uint8_t, n>(_roots.subspan(idx * n, n)),
+          std::span<uint8_t, len * n>(sigs.subspan(off, len * n)),
+        });
+      }
+
+      sphincs_plus_xmss::build_tree<xh, n, w, v>(sk_seed, pk_seed, adrs, _nodes, reqs);
+
+      for (size_t i = frm; i < to; i++) {
+        const size_t idx = order[i];
+        const size_t off = idx * siglen + n + fors_sl + static_cast<size_t>(j) * xmss_sig_len + len * n;
+
+        auto msg = _roots.subspan(idx * n, n);
+        auto path = std::span<uint8_t, xh * n>(sigs.subspan(off, xh * n));
+
+        sphincs_plus_xmss::auth_path_from_tree<xh, n>(ileafs[idx], _nodes, path);
+        std::copy(root.begin(), root.end(), msg.begin());
+      }
+
+      frm = to;
+    }
+  }
+}
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "hashing.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+// Verified-node cache, for HyperTree signature verification, under a single SPHINCS+ public key
+namespace sphincs_plus_node_cache {
+
+// Opt-in cache of authenticated XMSS tree roots, bound to a SPHINCS+ public key, which is filled during successful
+// HyperTree signature verifications. Once root of the XMSS tree at (layer j, tree address t) is recomputed from a
+// signature and found to be equal to a cached authenticated root of same tree, rest of the HyperTree signature, above
+// layer j, doesn't need to be verified, because the cached root was already authenticated against the public key.
+//
+// Layer d-1 holds a single XMSS tree, whose root is the public key itself, so it's never cached. Layer j ( < d-1 )
+// holds 2^(h - (j+1) * h/d) -many XMSS trees, so upper layers are small and cached roots get hit very often, when
+// verifying many signatures under same public key.
+//
+// Each cacheable layer is a direct-mapped table of min(capacity, # -of trees in layer) -many slots ( rounded up to power
+// of 2 ), indexed by lower bits of tree address, so memory usage is bounded by (d - 1) * capacity * (n + 16) -bytes.
+// Cache is safe to be shared among threads.
+//
+// Besides public key, cache is bound to Winternitz parameter w and tweakable hash function variant, as template
+// parameters, because an XMSS tree root, authenticated under some other hashing rules, must never be reused. So passing
+// a cache instantiated for another w or variant, to HyperTree signature verification, doesn't compile.
+template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
+struct node_cache_t
+{
+private:
+  static constexpr uint32_t h_ = h / d;
+
+  struct entry_t
+  {
+    bool valid = false;
+    uint64_t tree = 0;
+    std::array<uint8_t, n> root{};
+  };
+
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> pk_root{};
+
+  std::array<std::vector<entry_t>, d> tables{};
+  mutable std::array<std::shared_mutex, d> locks{};
+
+  std::array<std::atomic<uint64_t>, d> layer_hits{};
+  std::atomic<uint64_t> misses = 0;
+
+  // Compile-time evaluable routine, computing log2 of # -of XMSS trees living on layer `j` of HyperTree.
+  static inline constexpr uint32_t log2_tree_cnt(const uint32_t j) { return h - (j + 1) * h_; }
+
+public:
+  // Constructs an empty verified-node cache, for SPHINCS+ public key ( = pk_seed || pk_root ), remembering at max
+  // `capacity` (>0) -many authenticated XMSS tree roots per HyperTree layer.
+  inline node_cache_t(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, n> pk_root, const size_t capacity = 1ul << 12)
+  {
+    std::copy(pk_seed.begin(), pk_seed.end(), this->pk_seed.begin());
+    std::copy(pk_root.begin(), pk_root.end(), this->pk_root.begin());
+
+    const size_t slots = std::bit_ceil(std::max<size_t>(capacity, 1));
+    const uint32_t log2_slots = static_cast<uint32_t>(std::countr_zero(slots));
+
+    for (uint32_t j = 0; j + 1 < d; j++) {
+      tables[j].resize(1ul << std::min(log2_slots, log2_tree_cnt(j)));
+    }
+  }
+
+  // Checks whether this cache is bound to given SPHINCS+ public key ( = pk_seed || pk_root ).
+  inline bool is_bound_to(std::span<const uint8_t, n> pk_seed, std::span<const uint8_t, n> pk_root) const
+  {
+    return std::equal(pk_seed.begin(), pk_seed.end(), this->pk_seed.begin()) && std::equal(pk_root.begin(), pk_root.end(), this->pk_root.begin());
+  }
+
+  // Checks whether n -bytes root of XMSS tree, at given layer and tree address, is already authenticated.
+  inline bool contains(const uint32_t layer, const uint64_t tree, std::span<const uint8_t, n> root) const
+  {
+    if (layer + 1 >= d) {
+      return false;
+    }
+
+    const auto& table = tables[layer];
+    const auto& entry = table[tree & (table.size() - 1)];
+
+    std::shared_lock<std::shared_mutex> guard(locks[layer]);
+    return entry.valid && (entry.tree == tree) && std::equal(root.begin(), root.end(), entry.root.begin());
+  }
+
+  // Remembers authenticated n -bytes root of XMSS tree, at given layer and tree address, evicting whichever root was
+  // occupying the same slot.
+  inline void insert(const uint32_t layer, const uint64_t tree, std::span<const uint8_t, n> root)
+  {
+    if (layer + 1 >= d) {
+      return;
+    }
+
+    auto& table = tables[layer];
+    auto& entry = table[tree & (table.size() - 1)];
+
+    std::unique_lock<std::shared_mutex> guard(locks[layer]);
+    entry.valid = true;
+    entry.tree = tree;
+    std::copy(root.begin(), root.end(), entry.root.begin());
+  }
+
+  // Records that HyperTree signature verification stopped early, at given layer.
+  inline void record_hit(const uint32_t layer) { layer_hits[layer].fetch_add(1, std::memory_order_relaxed); }
+
+  // Records that HyperTree signature verification didn't find any authenticated root in cache.
+  inline void record_miss() { misses.fetch_add(1, std::memory_order_relaxed); }
+
+  // Returns # -of HyperTree signature verifications which stopped early, at given layer.
+  inline uint64_t get_layer_hits(const uint32_t layer) const { return layer_hits[layer].load(std::memory_order_relaxed); }
+
+  // Returns # -of HyperTree signature verifications which stopped early, at any layer.
+  inline uint64_t get_hits() const
+  {
+    uint64_t hits = 0;
+    for (uint32_t j = 0; j < d; j++) {
+      hits += get_layer_hits(j);
+    }
+
+    return hits;
+  }
+
+  // Returns # -of HyperTree signature verifications which didn't find any authenticated root in cache.
+  inline uint64_t get_misses() const { return misses.load(std::memory_order_relaxed); }
+
+  // Returns fraction of HyperTree signature verifications which stopped early.
+  inline double get_hit_rate() const
+  {
+    const uint64_t hits = get_hits();
+    const uint64_t total = hits + get_misses();
+
+    return total == 0 ? 0. : static_cast<double>(hits) / static_cast<double>(total);
+  }
+};
+
+}
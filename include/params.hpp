@@ -6,66 +6,95 @@
 // Compile-time checks ensuring SPHINCS+ is instantiated with correct parameters
 namespace sphincs_plus_params {
 
-// Compile-time check to ensure that SPHINCS+ key generation function is only
-// invoked with parameter sets suggested in table 3 of the specification
+// Compile-time check to ensure that HyperTree's total height ( say h ) and
+// number of layers ( say d ) are conformant so that we can use 64 -bit unsigned
+// integer for indexing tree.
+//
+// Read more about this constraint in section 4.2.4 of the specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
-template<size_t n, uint32_t h, uint32_t d, size_t w, sphincs_plus_hashing::variant v>
 static inline constexpr bool
-check_keygen_params()
+check_ht_height_and_layer(const uint32_t h, const uint32_t d)
 {
-  constexpr bool flg0 = w == 16;
-  constexpr bool flg1 = (v == sphincs_plus_hashing::variant::robust) | (v == sphincs_plus_hashing::variant::simple);
+  return (h - (h / d)) <= 64u;
+}
 
-  constexpr bool flg2 = (n == 16) & (h == 63) & (d == 7);
-  constexpr bool flg3 = (n == 16) & (h == 66) & (d == 22);
-  constexpr bool flg4 = (n == 24) & (h == 63) & (d == 7);
-  constexpr bool flg5 = (n == 24) & (h == 66) & (d == 22);
-  constexpr bool flg6 = (n == 32) & (h == 64) & (d == 8);
-  constexpr bool flg7 = (n == 32) & (h == 68) & (d == 17);
+// Compile-time check to ensure that `w` parameter takes only allowed values.
+//
+// See Winternitz Parameter point in section 3.1 of
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+static inline constexpr bool
+check_w(const size_t w)
+{
+  return (w == 4) || (w == 16) || (w == 256);
+}
 
-  return (flg2 | flg3 | flg4 | flg5 | flg6 | flg7) & flg0 & flg1;
+// Compile-time check to ensure that security parameter `n` ( byte length of
+// hash output, keys and seeds ) is one of those, NIST security levels 1, 3 and 5
+// are defined for, so that F, H and PRF fit in a single SHAKE256 block.
+//
+// See table 3 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+static inline constexpr bool
+check_n(const size_t n)
+{
+  return (n == 16) || (n == 24) || (n == 32);
 }
 
-// Compile-time check to ensure that SPHINCS+ sign/ verify function is only
-// invoked with parameter sets suggested in table 3 of the specification
-// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
-template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+// Compile-time check to ensure that tweakable hash functions are instantiated
+// as either of robust or simple.
+//
+// See section 7.2 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 static inline constexpr bool
-check_sign_verify_params()
+check_variant(const sphincs_plus_hashing::variant v)
 {
-  constexpr bool flg0 = w == 16;
-  constexpr bool flg1 = (v == sphincs_plus_hashing::variant::robust) || (v == sphincs_plus_hashing::variant::simple);
+  return (v == sphincs_plus_hashing::variant::robust) || (v == sphincs_plus_hashing::variant::simple);
+}
 
-  const bool flg2 = (n == 16) & (h == 63) & (d == 7) & (a == 12) & (k == 14);
-  const bool flg3 = (n == 16) & (h == 66) & (d == 22) & (a == 6) & (k == 33);
-  const bool flg4 = (n == 24) & (h == 63) & (d == 7) & (a == 14) & (k == 17);
-  const bool flg5 = (n == 24) & (h == 66) & (d == 22) & (a == 8) & (k == 33);
-  const bool flg6 = (n == 32) & (h == 64) & (d == 8) & (a == 14) & (k == 22);
-  const bool flg7 = (n == 32) & (h == 68) & (d == 17) & (a == 9) & (k == 35);
+// Compile-time check to ensure that HyperTree of total height h is split into
+// d ( > 0 ) layers of XMSS trees of equal height h / d ( > 0 ), s.t. leaf index
+// of a XMSS tree fits in 4 -bytes.
+//
+// See section 4.2 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+static inline constexpr bool
+check_xmss_height(const uint32_t h, const uint32_t d)
+{
+  return (d > 0u) && (h % d == 0u) && (h / d > 0u) && (h / d < 32u);
+}
 
-  return (flg2 | flg3 | flg4 | flg5 | flg6 | flg7) & flg0 & flg1;
+// Compile-time check to ensure that k * a -bit message digest can be split into
+// k -many FORS leaf indices, each of a ( > 0 ) -bits, s.t. leaf index across all
+// k trees ( i.e. i * 2^a + idx, for i-th tree ) fits in 4 -bytes tree index of
+// FORS address.
+//
+// See section 5 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+static inline constexpr bool
+check_fors(const uint32_t a, const uint32_t k)
+{
+  return (a > 0u) && (a < 32u) && (k > 0u) && ((static_cast<uint64_t>(k) << a) <= (1ul << 32));
 }
 
-// Compile-time check to ensure that HyperTree's total height ( say h ) and
-// number of layers ( say d ) are conformant so that we can use 64 -bit unsigned
-// integer for indexing tree.
+// Compile-time check to ensure that SPHINCS+ key generation function is only
+// invoked with parameters satisfying constraints of the specification. Besides
+// parameter sets suggested in its table 3, custom ones, say with a shallower
+// HyperTree or larger w, are accepted, as long as they do.
 //
-// Read more about this constraint in section 4.2.4 of the specification
-// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+// See https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+template<size_t n, uint32_t h, uint32_t d, size_t w, sphincs_plus_hashing::variant v>
 static inline constexpr bool
-check_ht_height_and_layer(const uint32_t h, const uint32_t d)
+check_keygen_params()
 {
-  return (h - (h / d)) <= 64u;
+  return check_n(n) && check_variant(v) && check_w(w) && check_xmss_height(h, d) && check_ht_height_and_layer(h, d);
 }
 
-// Compile-time check to ensure that `w` parameter takes only allowed values.
+// Compile-time check to ensure that SPHINCS+ sign/ verify function is only
+// invoked with parameters satisfying constraints of key generation, along with
+// ones on FORS parameters a and k.
 //
-// See Winternitz Parameter point in section 3.1 of
-// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+// See https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
 static inline constexpr bool
-check_w(const size_t w)
+check_sign_verify_params()
 {
-  return (w == 4) || (w == 16) || (w == 256);
+  return check_keygen_params<n, h, d, w, v>() && check_fors(a, k);
 }
 
 }
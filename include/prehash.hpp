@@ -0,0 +1,183 @@
+#pragma once
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+// Parallel, tree hashing based message pre-hashing for SPHINCS+, suitable for signing/ verifying very large messages
+namespace sphincs_plus_prehash {
+
+// Default message block length ( in bytes ), each block is compressed independently and may be hashed by a different thread
+constexpr size_t DEFAULT_BLOCK_LEN = 8192;
+
+// Byte length of chaining value, computed by compressing each message block, following ParallelHash256
+constexpr size_t CV_LEN = 64;
+
+// Given a non-negative integer x, this routine encodes it as a byte string s.t. length of encoding is prepended,
+// following `left_encode` in section 2.3.1 of NIST SP 800-185 https://doi.org/10.6028/NIST.SP.800-185. Returns
+// number of bytes written to `enc`, which is at max 9.
+static inline size_t
+left_encode(const uint64_t x, std::span<uint8_t, 9> enc)
+{
+  const size_t blen = std::max<size_t>(1, (std::bit_width(x) + 7) / 8);
+
+  enc[0] = static_cast<uint8_t>(blen);
+  for (size_t i = 0; i < blen; i++) {
+    enc[1 + i] = static_cast<uint8_t>(x >> ((blen - 1 - i) * 8));
+  }
+
+  return blen + 1;
+}
+
+// Given a non-negative integer x, this routine encodes it as a byte string s.t. length of encoding is appended,
+// following `right_encode` in section 2.3.1 of NIST SP 800-185 https://doi.org/10.6028/NIST.SP.800-185. Returns
+// number of bytes written to `enc`, which is at max 9.
+static inline size_t
+right_encode(const uint64_t x, std::span<uint8_t, 9> enc)
+{
+  const size_t blen = std::max<size_t>(1, (std::bit_width(x) + 7) / 8);
+
+  for (size_t i = 0; i < blen; i++) {
+    enc[i] = static_cast<uint8_t>(x >> ((blen - 1 - i) * 8));
+  }
+  enc[blen] = static_cast<uint8_t>(blen);
+
+  return blen + 1;
+}
+
+// Compresses message blocks [frm, to), each of `block_len` -bytes ( except possibly the last block of message, which
+// can be shorter ), into 64 -bytes chaining values, using SHAKE256 i.e. cSHAKE256 with empty function name and
+// customization string, writing them to `cvs`, which must be (to - frm) * 64 -bytes wide.
+static inline void
+compress_blocks(std::span<const uint8_t> msg, const size_t block_len, const size_t frm, const size_t to, std::span<uint8_t> cvs)
+{
+  for (size_t i = frm; i < to; i++) {
+    const size_t moff = i * block_len;
+    const size_t mlen = std::min(block_len, msg.size() - moff);
+    const size_t coff = (i - frm) * CV_LEN;
+
+    shake256::shake256_t hasher;
+
+    hasher.absorb(msg.subspan(moff, mlen));
+    hasher.finalize();
+    hasher.squeeze(cvs.subspan(coff, CV_LEN));
+  }
+}
+
+// Given a message of arbitrary length, this routine computes a dlen -bytes digest of it, by splitting the message into
+// `block_len` -bytes blocks, compressing those blocks independently, on `thread_cnt` -many threads, and finally
+// hashing the concatenation of all chaining values, along with encoded block length, number of blocks and output bit
+// length. It follows the ParallelHash256 construction, described in section 6 of NIST SP 800-185
+// https://doi.org/10.6028/NIST.SP.800-185, with empty customization string.
+//
+// Note, the final compression uses SHAKE256 over bytepad(encode_string("ParallelHash") || encode_string(""), 136)
+// || newX, instead of cSHAKE256, because the SHA3 dependency only exposes SHAKE256 padding. So the digest keeps
+// ParallelHash256's structure and domain separation, but it doesn't match SP 800-185 test vectors.
+//
+// Digest is independent of `thread_cnt`, but it depends on `block_len`, so signer and verifier must agree on it.
+template<size_t dlen>
+static inline void
+parallel_hash(std::span<const uint8_t> msg,
+              std::span<uint8_t, dlen> dig,
+              const size_t block_len = DEFAULT_BLOCK_LEN,
+              const size_t thread_cnt = std::thread::hardware_concurrency())
+{
+  assert(block_len > 0);
+
+  const size_t blk_cnt = (msg.size() + block_len - 1) / block_len;
+  const size_t thd_cnt = std::clamp<size_t>(thread_cnt, 1, std::max<size_t>(blk_cnt, 1));
+
+  std::vector<uint8_t> cvs(blk_cnt * CV_LEN, 0);
+  auto _cvs = std::span(cvs);
+
+  if (thd_cnt == 1) {
+    compress_blocks(msg, block_len, 0, blk_cnt, _cvs);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(thd_cnt - 1);
+
+    // Each thread compresses a contiguous range of blocks, while the calling thread takes the last range
+    const size_t per_thd = blk_cnt / thd_cnt;
+    const size_t extra = blk_cnt % thd_cnt;
+
+    size_t frm = 0;
+    for (size_t i = 0; i < thd_cnt; i++) {
+      const size_t to = frm + per_thd + static_cast<size_t>(i < extra);
+      auto __cvs = _cvs.subspan(frm * CV_LEN, (to - frm) * CV_LEN);
+
+      if (i + 1 < thd_cnt) {
+        workers.emplace_back(compress_blocks, msg, block_len, frm, to, __cvs);
+      } else {
+        compress_blocks(msg, block_len, frm, to, __cvs);
+      }
+
+      frm = to;
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // bytepad(encode_string("ParallelHash") || encode_string(""), 136)
+  constexpr std::array<uint8_t, 18> fn_name{ 0x01, 0x88, 0x01, 0x60, 'P', 'a', 'r', 'a', 'l', 'l', 'e', 'l', 'H', 'a', 's', 'h', 0x01, 0x00 };
+  std::array<uint8_t, 136> prefix{};
+  std::copy(fn_name.begin(), fn_name.end(), prefix.begin());
+
+  std::array<uint8_t, 9> enc{};
+  auto _enc = std::span(enc);
+
+  shake256::shake256_t hasher;
+
+  hasher.absorb(prefix);
+  hasher.absorb(_enc.subspan(0, left_encode(block_len, _enc)));
+  hasher.absorb(_cvs);
+  hasher.absorb(_enc.subspan(0, right_encode(blk_cnt, _enc)));
+  hasher.absorb(_enc.subspan(0, right_encode(dlen * 8, _enc)));
+  hasher.finalize();
+  hasher.squeeze(dig);
+}
+
+// Computes SPHINCS+ signature over 2*n -bytes ParallelHash digest of message of arbitrary length, using 4*n -bytes
+// secret key. Message is pre-hashed in `block_len` -bytes blocks, on `thread_cnt` -many threads, see `parallel_hash`.
+// Randomized signing works same as `sphincs_plus::sign`.
+//
+// Note, a signature produced by this routine is a valid SPHINCS+ signature over the 2*n -bytes digest, so verifier
+// must use `sphincs_plus_prehash::verify`, with same block length, for verifying it.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize = false>
+static inline void
+sign(std::span<const uint8_t> msg,
+     std::span<const uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
+     std::span<const uint8_t, n * randomize> rand_bytes,
+     std::span<uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+     const size_t block_len = DEFAULT_BLOCK_LEN,
+     const size_t thread_cnt = std::thread::hardware_concurrency())
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  std::array<uint8_t, 2 * n> dig{};
+  parallel_hash<dig.size()>(msg, dig, block_len, thread_cnt);
+
+  sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(dig, skey, rand_bytes, sig);
+}
+
+// Verifies SPHINCS+ signature over ParallelHash digest of message of arbitrary length, using 2*n -bytes public key,
+// returning truth value in case of successful verification. Message is pre-hashed in `block_len` -bytes blocks, on
+// `thread_cnt` -many threads, see `parallel_hash`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+verify(std::span<const uint8_t> msg,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey,
+       const size_t block_len = DEFAULT_BLOCK_LEN,
+       const size_t thread_cnt = std::thread::hardware_concurrency())
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  std::array<uint8_t, 2 * n> dig{};
+  parallel_hash<dig.size()>(msg, dig, block_len, thread_cnt);
+
+  return sphincs_plus::verify<n, h, d, a, k, w, v>(dig, sig, pkey);
+}
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+#include "sphincs+.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Verified-signature result cache, for skipping repeated verification of same (public key, message, signature) triple
+namespace sphincs_plus_sig_cache {
+
+// Byte length of fingerprint of (public key, message, signature) triple.
+constexpr size_t FP_LEN = 32;
+
+// Domain separation prefix, for computing fingerprint, so that it can't be confused with any other SHAKE256 digest.
+constexpr uint8_t FP_PREFIX = 0x04;
+
+// Byte length of parameter set tag, which is absorbed into fingerprint.
+constexpr size_t TAG_LEN = 10;
+
+// Compile-time encodes SPHINCS+ parameter set as tag s.t.
+// tag = n (1 -byte) || h (1 -byte) || d (1 -byte) || a (1 -byte) || k (4 -bytes, big-endian) || log2(w) (1 -byte) || variant (1 -byte)
+//
+// Robust and simple variants of a parameter set have same key and signature lengths, so without binding parameter set,
+// a triple verified under one of them would be found in cache, when looked up under the other one.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr std::array<uint8_t, TAG_LEN>
+param_tag()
+{
+  return { static_cast<uint8_t>(n),
+           static_cast<uint8_t>(h),
+           static_cast<uint8_t>(d),
+           static_cast<uint8_t>(a),
+           static_cast<uint8_t>(k >> 24),
+           static_cast<uint8_t>(k >> 16),
+           static_cast<uint8_t>(k >> 8),
+           static_cast<uint8_t>(k),
+           static_cast<uint8_t>(sphincs_plus_utils::log2<w>()),
+           static_cast<uint8_t>(v) };
+}
+
+// Given SPHINCS+ public key, message and signature, this routine computes 32 -bytes fingerprint of the triple, under
+// parameter set (n, h, d, a, k, w, v) s.t.
+// fingerprint = SHAKE256(FP_PREFIX || parameter set tag || public key || signature || message length (8 -bytes, big-endian) || message)
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+fingerprint(std::span<const uint8_t> pkey, std::span<const uint8_t> msg, std::span<const uint8_t> sig, std::span<uint8_t, FP_LEN> fp)
+{
+  constexpr std::array<uint8_t, 1> prefix{ FP_PREFIX };
+  constexpr std::array<uint8_t, TAG_LEN> tag = param_tag<n, h, d, a, k, w, v>();
+
+  std::array<uint8_t, 8> mlen{};
+  auto _mlen = std::span(mlen);
+
+  sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(static_cast<uint64_t>(msg.size()) >> 32), _mlen.template subspan<0, 4>());
+  sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(msg.size()), _mlen.template subspan<4, 4>());
+
+  shake256::shake256_t hasher;
+
+  hasher.absorb(prefix);
+  hasher.absorb(tag);
+  hasher.absorb(pkey);
+  hasher.absorb(sig);
+  hasher.absorb(mlen);
+  hasher.absorb(msg);
+  hasher.finalize();
+  hasher.squeeze(fp);
+}
+
+// Bounded set of fingerprints of (public key, message, signature) triples, which were successfully verified. Only
+// positive results are ever remembered, so that a cache hit can never turn an invalid signature into a valid one.
+//
+// Cache is split into a power of 2 -many shards, each guarded by its own lock, so that concurrent lookups rarely
+// contend. Each shard is a direct-mapped table, indexed by fingerprint bits, so both lookup and insertion are O(1) and
+// memory usage is bounded by ~capacity * 40 -bytes. Inserting a fingerprint into an occupied slot evicts the older one.
+struct cache_t
+{
+private:
+  struct entry_t
+  {
+    bool valid = false;
+    std::array<uint8_t, FP_LEN> fp{};
+  };
+
+  struct alignas(64) shard_t
+  {
+    std::mutex lock;
+    std::vector<entry_t> entries;
+  };
+
+  std::vector<shard_t> shards;
+  size_t shard_mask = 0;
+  size_t slot_mask = 0;
+
+  std::atomic<uint64_t> hits = 0;
+  std::atomic<uint64_t> misses = 0;
+  std::atomic<uint64_t> insertions = 0;
+  std::atomic<uint64_t> evictions = 0;
+
+  // Interprets 8 -bytes of fingerprint, starting at `off`, as a little-endian 64 -bit unsigned integer.
+  static inline uint64_t fp_word(std::span<const uint8_t, FP_LEN> fp, const size_t off)
+  {
+    uint64_t word = 0;
+    for (size_t i = 0; i < 8; i++) {
+      word |= static_cast<uint64_t>(fp[off + i]) << (i * 8);
+    }
+
+    return word;
+  }
+
+  inline shard_t& shard_of(std::span<const uint8_t, FP_LEN> fp) { return shards[fp_word(fp, 0) & shard_mask]; }
+  inline size_t slot_of(std::span<const uint8_t, FP_LEN> fp) const { return fp_word(fp, 8) & slot_mask; }
+
+public:
+  // Constructs an empty cache, which can remember ~`capacity` (>0) -many fingerprints, spread over `shard_cnt` (>0)
+  // -many shards. Both are rounded up to next power of 2.
+  inline explicit cache_t(const size_t capacity = 1ul << 16, const size_t shard_cnt = 16)
+    : shards(std::bit_ceil(std::max<size_t>(shard_cnt, 1)))
+  {
+    const size_t slots = std::max<size_t>(std::bit_ceil(std::max<size_t>(capacity, 1)) / shards.size(), 1);
+
+    for (auto& shard : shards) {
+      shard.entries.resize(slots);
+    }
+
+    shard_mask = shards.size() - 1;
+    slot_mask = slots - 1;
+  }
+
+  // Checks whether fingerprint of a (public key, message, signature) triple is known to be successfully verified.
+  inline bool contains(std::span<const uint8_t, FP_LEN> fp)
+  {
+    auto& shard = shard_of(fp);
+    const auto& entry = shard.entries[slot_of(fp)];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    const bool flg = entry.valid && std::equal(fp.begin(), fp.end(), entry.fp.begin());
+
+    (flg ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    return flg;
+  }
+
+  // Remembers fingerprint of a successfully verified (public key, message, signature) triple.
+  inline void insert(std::span<const uint8_t, FP_LEN> fp)
+  {
+    auto& shard = shard_of(fp);
+    auto& entry = shard.entries[slot_of(fp)];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if (entry.valid) {
+      if (std::equal(fp.begin(), fp.end(), entry.fp.begin())) {
+        return;
+      }
+
+      evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    entry.valid = true;
+    std::copy(fp.begin(), fp.end(), entry.fp.begin());
+    insertions.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Forgets all remembered fingerprints, while keeping metrics intact.
+  inline void clear()
+  {
+    for (auto& shard : shards) {
+      std::lock_guard<std::mutex> guard(shard.lock);
+      std::fill(shard.entries.begin(), shard.entries.end(), entry_t{});
+    }
+  }
+
+  // Returns # -of fingerprint slots, across all shards.
+  inline size_t get_capacity() const { return shards.size() * (slot_mask + 1); }
+
+  // Returns # -of lookups which found the fingerprint.
+  inline uint64_t get_hits() const { return hits.load(std::memory_order_relaxed); }
+
+  // Returns # -of lookups which didn't find the fingerprint.
+  inline uint64_t get_misses() const { return misses.load(std::memory_order_relaxed); }
+
+  // Returns # -of fingerprints inserted.
+  inline uint64_t get_insertions() const { return insertions.load(std::memory_order_relaxed); }
+
+  // Returns # -of fingerprints evicted, for making room for a newer one.
+  inline uint64_t get_evictions() const { return evictions.load(std::memory_order_relaxed); }
+
+  // Returns fraction of lookups which found the fingerprint.
+  inline double get_hit_rate() const
+  {
+    const uint64_t _hits = get_hits();
+    const uint64_t total = _hits + get_misses();
+
+    return total == 0 ? 0. : static_cast<double>(_hits) / static_cast<double>(total);
+  }
+};
+
+// Verifies a SPHINCS+ signature on a message of mlen -bytes using SPHINCS+ public key of length 2*n -bytes, consulting
+// verified-signature result cache first, returning truth value in case of successful signature verification. Only
+// successfully verified triples are remembered by cache, so that repeated verification of those costs a single SHAKE256
+// fingerprint computation.
+//
+// Note, a fingerprint must cover the whole signature, as a hit must only ever be reported for the very signature which
+// was verified. So a cache hit still absorbs ~(2*n + siglen + mlen) -bytes, into SHAKE256, i.e. ~59 Keccak-f[1600]
+// permutations for 128s and ~368 for 256f, with 32 -bytes message. As measured by `*/verify_sig_cache` benchmarks, a
+// hit costs ~12% to ~24% of a full verification, depending on parameter set, not a negligible amount.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+verify(std::span<const uint8_t> msg,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey,
+       cache_t& cache)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  std::array<uint8_t, FP_LEN> fp{};
+  fingerprint<n, h, d, a, k, w, v>(pkey, msg, sig, fp);
+
+  if (cache.contains(fp)) {
+    return true;
+  }
+
+  const bool flg = sphincs_plus::verify<n, h, d, a, k, w, v>(msg, sig, pkey);
+  if (flg) {
+    cache.insert(fp);
+  }
+
+  return flg;
+}
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "fors.hpp"
 #include "hypertree.hpp"
+#include "tracing.hpp"
 
 // SPHINCS+ Signature Scheme, with generic API
 namespace sphincs_plus {
@@ -30,11 +31,12 @@ keygen(std::span<const uint8_t, n> sk_seed,
        std::span<const uint8_t, n> sk_prf,
        std::span<const uint8_t, n> pk_seed,
        std::span<uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
-       std::span<uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey)
+       std::span<uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey,
+       sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
   requires(sphincs_plus_params::check_keygen_params<n, h, d, w, v>())
 {
   std::array<uint8_t, n> pk_root{};
-  sphincs_plus_ht::pkgen<h, d, n, w, v>(sk_seed, pk_seed, pk_root);
+  sphincs_plus_ht::pkgen<h, d, n, w, v>(sk_seed, pk_seed, pk_root, ws);
 
   // prepare 2*n -bytes public key
   std::copy(pk_seed.begin(), pk_seed.end(), pkey.template subspan<0, n>().begin());
@@ -62,12 +64,17 @@ keygen(std::span<const uint8_t, n> sk_seed,
 //
 // This form of SPHINCS+ signing API will be useful when testing conformance
 // with SPHINCS+ standard, using known answer tests (KATs).
+//
+// Neither key generation nor signing allocates on heap. Scratch space for tree
+// nodes can optionally be supplied by caller, see `sphincs_plus_xmss::workspace_t`,
+// else it lives on call stack.
 template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize = false>
 static inline void
 sign(std::span<const uint8_t> msg,
      std::span<const uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
      std::span<const uint8_t, n * randomize> rand_bytes,
-     std::span<uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig)
+     std::span<uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+     sphincs_plus_xmss::workspace_t<n>* const ws = nullptr)
   requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
 {
   constexpr size_t md_len = static_cast<size_t>((k * a + 7) / 8);
@@ -77,6 +84,10 @@ sign(std::span<const uint8_t> msg,
 
   constexpr size_t fors_sl = sphincs_plus_utils::compute_fors_sig_len<n, a, k>();
 
+  namespace tracing = sphincs_plus_tracing;
+  constexpr uint64_t params = tracing::params<n, h, d, a, k, w, v>();
+  tracing::begin(tracing::phase_t::sign, 0u, params);
+
   auto _sig0 = sig.template subspan<0, n>();                                                              // Randomness portion
   auto _sig1 = sig.template subspan<n, fors_sl>();                                                        // FORS signature portion
   auto _sig2 = sig.template subspan<n + fors_sl, sphincs_plus_utils::compute_ht_sig_len<h, d, n, w>()>(); // HT signature portion
@@ -102,8 +113,13 @@ sign(std::span<const uint8_t> msg,
     std::copy(pk_seed.begin(), pk_seed.end(), opt.begin());
   }
 
+  tracing::begin(tracing::phase_t::prf_msg, 0u, params);
   sphincs_plus_hashing::prf_msg<n>(sk_prf, opt, msg, _sig0);
+  tracing::end(tracing::phase_t::prf_msg, 0u, params);
+
+  tracing::begin(tracing::phase_t::h_msg, 0u, params);
   sphincs_plus_hashing::h_msg<n, m>(_sig0, pk_seed, pk_root, msg, _dig);
+  tracing::end(tracing::phase_t::h_msg, 0u, params);
 
   auto md = _dig.template subspan<0, md_len>();
   auto tmp_itree = _dig.template subspan<md_len, itree_len>();
@@ -131,9 +147,15 @@ sign(std::span<const uint8_t> msg,
 
   std::array<uint8_t, n> tmp{};
 
-  sphincs_plus_fors::sign<n, a, k, v>(md, sk_seed, pk_seed, adrs, _sig1);
+  sphincs_plus_fors::sign<n, a, k, v>(md, sk_seed, pk_seed, adrs, _sig1, ws);
+
+  tracing::begin(tracing::phase_t::fors_pk_from_sig, 0u, params);
   sphincs_plus_fors::pk_from_sig<n, a, k, v>(_sig1, md, pk_seed, adrs, tmp);
-  sphincs_plus_ht::sign<h, d, n, w, v>(tmp, sk_seed, pk_seed, itree, ileaf, _sig2);
+  tracing::end(tracing::phase_t::fors_pk_from_sig, 0u, params);
+
+  sphincs_plus_ht::sign<h, d, n, w, v>(tmp, sk_seed, pk_seed, itree, ileaf, _sig2, ws);
+
+  tracing::end(tracing::phase_t::sign, 0u, params);
 }
 
 // Verifies a SPHINCS+ signature on a message of mlen -bytes using SPHINCS+
@@ -141,11 +163,16 @@ sign(std::span<const uint8_t> msg,
 // case of successful signature verification, following algorithm 21, as
 // described in section 6.5 of specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// When verifying many signatures under same public key, one may pass an
+// opt-in verified-node cache, bound to that public key, so that HyperTree
+// signature verification can stop early, see include/node_cache.hpp.
 template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
 static inline bool
 verify(std::span<const uint8_t> msg,
        std::span<const uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
-       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey)
+       std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey,
+       sphincs_plus_node_cache::node_cache_t<h, d, n, w, v>* const cache = nullptr)
   requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
 {
   constexpr size_t md_len = static_cast<size_t>((k * a + 7) / 8);
@@ -155,6 +182,10 @@ verify(std::span<const uint8_t> msg,
 
   constexpr size_t fors_sl = sphincs_plus_utils::compute_fors_sig_len<n, a, k>();
 
+  namespace tracing = sphincs_plus_tracing;
+  constexpr uint64_t params = tracing::params<n, h, d, a, k, w, v>();
+  tracing::begin(tracing::phase_t::verify, 0u, params);
+
   auto _sig0 = sig.template subspan<0, n>();                                                              // Randomness portion
   auto _sig1 = sig.template subspan<n, fors_sl>();                                                        // FORS signature portion
   auto _sig2 = sig.template subspan<n + fors_sl, sphincs_plus_utils::compute_ht_sig_len<h, d, n, w>()>(); // HT signature portion
@@ -170,7 +201,10 @@ verify(std::span<const uint8_t> msg,
 
   std::array<uint8_t, m> dig{};
   auto _dig = std::span(dig);
+
+  tracing::begin(tracing::phase_t::h_msg, 0u, params);
   sphincs_plus_hashing::h_msg<n, m>(_sig0, pk_seed, pk_root, msg, _dig);
+  tracing::end(tracing::phase_t::h_msg, 0u, params);
 
   auto md = _dig.template subspan<0, md_len>();
   auto tmp_itree = _dig.template subspan<md_len, itree_len>();
@@ -197,9 +231,17 @@ verify(std::span<const uint8_t> msg,
   adrs.set_keypair_address(ileaf);
 
   std::array<uint8_t, n> tmp{};
+
+  tracing::begin(tracing::phase_t::fors_pk_from_sig, 0u, params);
   sphincs_plus_fors::pk_from_sig<n, a, k, v>(_sig1, md, pk_seed, adrs, tmp);
+  tracing::end(tracing::phase_t::fors_pk_from_sig, 0u, params);
+
+  tracing::begin(tracing::phase_t::ht_verify, 0u, params);
+  const bool verified = sphincs_plus_ht::verify<h, d, n, w, v>(tmp, _sig2, pk_seed, itree, ileaf, pk_root, cache);
+  tracing::end(tracing::phase_t::ht_verify, 0u, params);
 
-  return sphincs_plus_ht::verify<h, d, n, w, v>(tmp, _sig2, pk_seed, itree, ileaf, pk_root);
+  tracing::end(tracing::phase_t::verify, 0u, params);
+  return verified;
 }
 
 }
@@ -0,0 +1,66 @@
+#pragma once
+#include "sphincs+.hpp"
+#include "utils.hpp"
+
+// SPHINCS+-SHAKE Signature Scheme, instantiated with a custom parameter set
+namespace sphincs_plus_custom {
+
+// Custom SPHINCS+ parameter set, bundling n, h, d, a, k, w and tweakable hash function variant, along with key and
+// signature lengths and keygen/ sign/ verify routines, same as the ones offered by parameter set specific headers, say
+// include/sphincs+_128f_simple.hpp.
+//
+// Instead of being restricted to parameter sets of table 3 of the specification, parameters are checked against its
+// constraints, at compile-time, see `sphincs_plus_params::check_sign_verify_params`. For example, a firmware signing
+// key, which only ever signs a few thousand images, may go for a shallow HyperTree, for much faster signing and smaller
+// signatures,
+//
+// using firmware_key = sphincs_plus_custom::params_t<16, 12, 2, 12, 10, 256, sphincs_plus_hashing::variant::simple>;
+//
+// Note, security of a custom parameter set, against the number of signatures made under same key, is for the caller to
+// establish, see section 9 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf.
+template<size_t n_, uint32_t h_, uint32_t d_, uint32_t a_, uint32_t k_, size_t w_, sphincs_plus_hashing::variant v_>
+  requires(sphincs_plus_params::check_sign_verify_params<n_, h_, d_, a_, k_, w_, v_>())
+struct params_t
+{
+  static constexpr size_t n = n_;
+  static constexpr uint32_t h = h_;
+  static constexpr uint32_t d = d_;
+  static constexpr uint32_t a = a_;
+  static constexpr uint32_t k = k_;
+  static constexpr size_t w = w_;
+  static constexpr sphincs_plus_hashing::variant v = v_;
+
+  // = 2 * n -bytes public key
+  static constexpr size_t PubKeyLen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+
+  // = 4 * n -bytes secret key
+  static constexpr size_t SecKeyLen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+
+  // = n + k * n * (a + 1) + (h + d * len) * n -bytes signature
+  static constexpr size_t SigLen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  static inline void keygen(std::span<const uint8_t, n> sk_seed,
+                            std::span<const uint8_t, n> sk_prf,
+                            std::span<const uint8_t, n> pk_seed,
+                            std::span<uint8_t, SecKeyLen> skey,
+                            std::span<uint8_t, PubKeyLen> pkey)
+  {
+    sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+  }
+
+  template<bool randomize = false>
+  static inline void sign(std::span<const uint8_t> msg,
+                          std::span<const uint8_t, SecKeyLen> skey,
+                          std::span<const uint8_t, n * randomize> rand_bytes,
+                          std::span<uint8_t, SigLen> sig)
+  {
+    sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(msg, skey, rand_bytes, sig);
+  }
+
+  static inline bool verify(std::span<const uint8_t> msg, std::span<const uint8_t, SigLen> sig, std::span<const uint8_t, PubKeyLen> pkey)
+  {
+    return sphincs_plus::verify<n, h, d, a, k, w, v>(msg, sig, pkey);
+  }
+};
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Runtime parameter set dispatch, for SPHINCS+-SHAKE signature scheme.
+//
+// Unlike rest of the headers, this one doesn't pull in any of the templates. Routines declared here are defined in
+// src/sphincs+_dispatch.cpp, which is compiled once into `libsphincs+` ( say, `make lib` ), holding the only
+// instantiations of keygen/ sign/ verify for all 12 parameter sets. Each call dispatches through a table, indexed by
+// parameter set, so that inner loops stay specialised at compile-time, while code doesn't grow at every call site.
+namespace sphincs_plus_dispatch {
+
+// SPHINCS+-SHAKE parameter sets, as specified in table 3 of https://sphincs.org/data/sphincs+-r3.1-specification.pdf.
+enum class param_set_t : uint8_t
+{
+  sphincs_plus_128s_robust = 0,
+  sphincs_plus_128s_simple = 1,
+  sphincs_plus_128f_robust = 2,
+  sphincs_plus_128f_simple = 3,
+  sphincs_plus_192s_robust = 4,
+  sphincs_plus_192s_simple = 5,
+  sphincs_plus_192f_robust = 6,
+  sphincs_plus_192f_simple = 7,
+  sphincs_plus_256s_robust = 8,
+  sphincs_plus_256s_simple = 9,
+  sphincs_plus_256f_robust = 10,
+  sphincs_plus_256f_simple = 11,
+};
+
+// # -of parameter sets, which can be dispatched to
+constexpr size_t PARAM_SET_CNT = 12;
+
+// Returns name of parameter set, say "sphincs+-128f-simple", or nullptr, for an unknown one.
+const char*
+name(param_set_t set);
+
+// Returns byte length of secret key seed, secret key PRF, public key seed and randomizer i.e. n, for given parameter
+// set, or 0, for an unknown one. Same goes for key and signature lengths, below.
+size_t
+n(param_set_t set);
+
+// Returns byte length of public key ( = 2 * n ).
+size_t
+pkey_len(param_set_t set);
+
+// Returns byte length of secret key ( = 4 * n ).
+size_t
+skey_len(param_set_t set);
+
+// Returns byte length of signature.
+size_t
+sig_len(param_set_t set);
+
+// Generates SPHINCS+ keypair, for given parameter set, from n -bytes secret key seed, n -bytes secret key PRF and
+// n -bytes public key seed, see `sphincs_plus::keygen`. Returns false, without touching keys, when parameter set is
+// unknown or any of the spans is not of expected length.
+bool
+keygen(param_set_t set,
+       std::span<const uint8_t> sk_seed,
+       std::span<const uint8_t> sk_prf,
+       std::span<const uint8_t> pk_seed,
+       std::span<uint8_t> skey,
+       std::span<uint8_t> pkey);
+
+// Signs message, for given parameter set, see `sphincs_plus::sign`. Signing is deterministic when `rand_bytes` is
+// empty, else it must be n -bytes of randomness. Returns false, without touching signature, when parameter set is
+// unknown or any of the spans is not of expected length.
+bool
+sign(param_set_t set, std::span<const uint8_t> msg, std::span<const uint8_t> skey, std::span<const uint8_t> rand_bytes, std::span<uint8_t> sig);
+
+// Verifies signature on message, for given parameter set, see `sphincs_plus::verify`. Returns false, when parameter set
+// is unknown, any of the spans is not of expected length or signature doesn't verify.
+bool
+verify(param_set_t set, std::span<const uint8_t> msg, std::span<const uint8_t> sig, std::span<const uint8_t> pkey);
+
+}
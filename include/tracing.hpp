@@ -0,0 +1,80 @@
+#pragma once
+#include "hashing.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Opt-in USDT ( user-level statically defined tracing ) probes, at boundaries of phases of SPHINCS+ signing and
+// verification. Probes are compiled in only when built with `-DSPHINCS_PLUS_TRACING` and systemtap's <sys/sdt.h> is
+// available, otherwise they compile down to nothing. When compiled in, each probe is a single `nop` instruction, until
+// a tracer ( say, bpftrace or perf ) attaches to it, so they cost nothing measurable on a live process.
+//
+// Each phase fires `sphincs_plus:phase_begin` and `sphincs_plus:phase_end`, both carrying three arguments
+//
+// - arg0 : phase, see `phase_t`
+// - arg1 : HyperTree layer index, for `ht_layer` phase, otherwise 0
+// - arg2 : parameter set, packed by `params`
+//
+// For example, a per-phase latency histogram can be built, using bpftrace, as
+//
+// bpftrace -e 'usdt:./a.out:sphincs_plus:phase_begin { @s[tid, arg0, arg1] = nsecs; }
+//              usdt:./a.out:sphincs_plus:phase_end /@s[tid, arg0, arg1]/ {
+//                @ns[arg0] = hist(nsecs - @s[tid, arg0, arg1]); delete(@s[tid, arg0, arg1]); }'
+#if defined SPHINCS_PLUS_TRACING && defined __has_include
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SPHINCS_PLUS_USDT 1
+#endif
+#endif
+
+namespace sphincs_plus_tracing {
+
+#if defined SPHINCS_PLUS_USDT
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// Phases of SPHINCS+ signing and verification, around which probes fire
+enum class phase_t : uint32_t
+{
+  sign = 0,             // sphincs_plus::sign, as a whole
+  verify = 1,           // sphincs_plus::verify, as a whole
+  prf_msg = 2,          // Computing randomizer R
+  h_msg = 3,            // Computing message digest
+  fors_sign = 4,        // sphincs_plus_fors::sign
+  fors_pk_from_sig = 5, // FORS public key, from FORS signature
+  ht_sign = 6,          // sphincs_plus_ht::sign, as a whole
+  ht_layer = 7,         // Signing on a single layer of HyperTree, carrying layer index
+  ht_verify = 8,        // sphincs_plus_ht::verify
+};
+
+// Compile-time packs a parameter set into a 64 -bit word, s.t. byte i ( from least significant end ) holds n, h, d,
+// a, k, for i = 0..4, bytes 5, 6 hold w and byte 7 holds variant. Probes fired by a component, which doesn't know whole
+// parameter set, carry zero in place of unknown parameters.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline constexpr uint64_t
+params()
+{
+  return static_cast<uint64_t>(n) | (static_cast<uint64_t>(h) << 8) | (static_cast<uint64_t>(d) << 16) | (static_cast<uint64_t>(a) << 24) |
+         (static_cast<uint64_t>(k) << 32) | (static_cast<uint64_t>(w) << 40) | (static_cast<uint64_t>(v) << 56);
+}
+
+// Fires probe, marking beginning of a phase.
+static inline void
+begin([[maybe_unused]] const phase_t phase, [[maybe_unused]] const uint32_t layer, [[maybe_unused]] const uint64_t params)
+{
+#if defined SPHINCS_PLUS_USDT
+  STAP_PROBE3(sphincs_plus, phase_begin, static_cast<uint32_t>(phase), layer, params);
+#endif
+}
+
+// Fires probe, marking end of a phase.
+static inline void
+end([[maybe_unused]] const phase_t phase, [[maybe_unused]] const uint32_t layer, [[maybe_unused]] const uint64_t params)
+{
+#if defined SPHINCS_PLUS_USDT
+  STAP_PROBE3(sphincs_plus, phase_end, static_cast<uint32_t>(phase), layer, params);
+#endif
+}
+
+}
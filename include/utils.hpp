@@ -45,11 +45,15 @@ template<size_t n, size_t w, size_t len1>
 static inline constexpr size_t
 compute_wots_len2()
 {
-  constexpr size_t t0 = len1 * (w - 1);
-  constexpr size_t t1 = std::bit_width(t0);
-  constexpr size_t t2 = t1 / log2<w>();
-  constexpr size_t t3 = t2 + 1;
-  return t3;
+  // = floor(log_w(len1 * (w - 1))), computed using integer arithmetic only
+  size_t t0 = len1 * (w - 1);
+  size_t t1 = 0;
+  while (t0 >= w) {
+    t0 /= w;
+    t1++;
+  }
+
+  return t1 + 1;
 }
 
 // Compile-time compute `len` parameter for WOTS+
@@ -0,0 +1,267 @@
+#pragma once
+#include "merkle.hpp"
+#include "sphincs+.hpp"
+#include <limits>
+#include <thread>
+
+// Chunk-level Signed Content: a single SPHINCS+ signature, over root of a Merkle Tree built on fixed-size chunks of a
+// large object, lets a reader verify any chunk, without hashing the whole object
+namespace sphincs_plus_verity {
+
+// Domain separation prefix, for object header which gets signed using SPHINCS+, so that it can't be confused with a
+// batch signature ( see include/batch_sign.hpp, prefix 0x02 ), under same key. Note, regular messages aren't prefixed
+// by `sphincs_plus::sign`, so a regular SPHINCS+ signature over 0x03 || ... is indistinguishable from a chunk-level
+// signature. Don't use a key for both, unless regular messages can never start with this prefix.
+constexpr uint8_t ROOT_PREFIX = 0x03;
+
+using sphincs_plus_merkle::get_node_len;
+
+// Compile-time compute byte length of object header, which is signed using SPHINCS+ s.t.
+// header = ROOT_PREFIX (1 -byte) || chunk length (4 -bytes, big-endian) || object length (8 -bytes, big-endian) ||
+// tree height (1 -byte) || root (2*n -bytes)
+template<size_t n>
+static inline constexpr size_t
+get_header_len()
+{
+  return 1 + 4 + 8 + 1 + get_node_len<n>();
+}
+
+// Computes # -of chunks, an object of `object_len` -bytes is split into, s.t. each chunk is `chunk_len` -bytes, except
+// possibly the last one. An empty object has a single empty chunk.
+static inline constexpr size_t
+get_chunk_cnt(const uint64_t object_len, const size_t chunk_len)
+{
+  return std::max<size_t>(1, static_cast<size_t>((object_len + chunk_len - 1) / chunk_len));
+}
+
+// Computes byte length of inclusion proof of each chunk i.e. authentication path, for an object of `object_len` -bytes,
+// which is split into `chunk_len` -bytes chunks.
+template<size_t n>
+static inline constexpr size_t
+get_proof_len(const uint64_t object_len, const size_t chunk_len)
+{
+  return static_cast<size_t>(sphincs_plus_merkle::compute_depth(get_chunk_cnt(object_len, chunk_len))) * get_node_len<n>();
+}
+
+// Merkle Tree over fixed-size chunks of an object, built by the publisher of the object, which can be used for
+// producing object header ( to be signed ) and inclusion proof of each chunk.
+template<size_t n>
+struct tree_t
+{
+private:
+  static constexpr size_t m = get_node_len<n>();
+
+  std::vector<uint8_t> nodes;
+  size_t chunk_len = 0;
+  uint64_t object_len = 0;
+  size_t chunk_cnt = 0;
+  uint32_t depth = 0;
+
+  // Computes leaves ( i.e. hashes of chunks or empty nodes ) at index [frm, to) and all internal nodes, which only
+  // depend on those leaves, up to level `till`.
+  inline void build_subtree(std::span<const uint8_t> object, const size_t frm, const size_t to, const uint32_t till)
+  {
+    auto _nodes = std::span(nodes);
+
+    for (size_t i = frm; i < to; i++) {
+      auto leaf = std::span<uint8_t, m>(_nodes.subspan(i * m, m));
+
+      if (i < chunk_cnt) {
+        const size_t off = i * chunk_len;
+        sphincs_plus_merkle::hash_leaf<m>(object.subspan(off, std::min<size_t>(chunk_len, object.size() - off)), leaf);
+      } else {
+        std::fill(leaf.begin(), leaf.end(), 0x00);
+      }
+    }
+
+    for (uint32_t lvl = 0; lvl < till; lvl++) {
+      sphincs_plus_merkle::hash_level<m>(_nodes, depth, lvl, frm >> (lvl + 1), to >> (lvl + 1));
+    }
+  }
+
+public:
+  // Splits object into `chunk_len` -bytes chunks and builds Merkle Tree over them, on at max `thread_cnt` -many threads.
+  // Each thread builds a subtree over a contiguous range of chunks, while the calling thread computes top levels of the
+  // tree, once all subtrees are built.
+  //
+  // As chunk length is encoded in 4 -bytes of object header, it must be s.t. 0 < chunk_len < 2^32.
+  inline tree_t(std::span<const uint8_t> object, const size_t chunk_len, const size_t thread_cnt = std::thread::hardware_concurrency())
+    : chunk_len(chunk_len)
+    , object_len(object.size())
+    , chunk_cnt(sphincs_plus_verity::get_chunk_cnt(object.size(), chunk_len))
+    , depth(sphincs_plus_merkle::compute_depth(chunk_cnt))
+  {
+    assert((chunk_len > 0) && (chunk_len <= std::numeric_limits<uint32_t>::max()));
+    nodes.resize(sphincs_plus_merkle::compute_node_cnt(depth) * m);
+
+    const size_t leaf_cnt = 1ul << depth;
+
+    // # -of threads is rounded down to a power of 2, so that each thread gets a complete subtree
+    const size_t thd_cnt = std::bit_floor(std::clamp<size_t>(thread_cnt, 1, leaf_cnt));
+    const uint32_t split_lvl = depth - static_cast<uint32_t>(std::countr_zero(thd_cnt));
+    const size_t per_thd = leaf_cnt / thd_cnt;
+
+    std::vector<std::thread> workers;
+    workers.reserve(thd_cnt - 1);
+
+    for (size_t i = 1; i < thd_cnt; i++) {
+      workers.emplace_back(&tree_t::build_subtree, this, object, i * per_thd, (i + 1) * per_thd, split_lvl);
+    }
+    build_subtree(object, 0, per_thd, split_lvl);
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    for (uint32_t lvl = split_lvl; lvl < depth; lvl++) {
+      sphincs_plus_merkle::hash_level<m>(nodes, depth, lvl, 0, 1ul << (depth - lvl - 1));
+    }
+  }
+
+  // Returns # -of chunks, object is split into.
+  inline size_t get_chunk_cnt() const { return chunk_cnt; }
+
+  // Returns byte length of inclusion proof of each chunk.
+  inline size_t get_proof_len() const { return static_cast<size_t>(depth) * m; }
+
+  // Writes object header, binding chunk length, object length and root of Merkle Tree, which is to be signed.
+  inline void get_header(std::span<uint8_t, get_header_len<n>()> header) const
+  {
+    header[0] = ROOT_PREFIX;
+    sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(chunk_len), header.template subspan<1, 4>());
+    sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(object_len >> 32), header.template subspan<5, 4>());
+    sphincs_plus_utils::to_be_bytes(static_cast<uint32_t>(object_len), header.template subspan<9, 4>());
+    header[13] = static_cast<uint8_t>(depth);
+
+    auto root = std::span(nodes).last(m);
+    std::copy(root.begin(), root.end(), header.template subspan<14, m>().begin());
+  }
+
+  // Writes inclusion proof ( i.e. authentication path ) of chunk at index `chunk_idx`.
+  inline void get_proof(const size_t chunk_idx, std::span<uint8_t> proof) const
+  {
+    assert(chunk_idx < chunk_cnt);
+    sphincs_plus_merkle::auth_path<m>(nodes, depth, chunk_idx, proof);
+  }
+};
+
+// Given object header, index of a chunk, chunk itself and its inclusion proof, this routine checks whether the chunk
+// belongs to the object, described by the header, returning truth value if it does. This routine doesn't verify
+// SPHINCS+ signature over header.
+template<size_t n>
+static inline bool
+check_chunk(std::span<const uint8_t, get_header_len<n>()> header, const size_t chunk_idx, std::span<const uint8_t> chunk, std::span<const uint8_t> proof)
+{
+  constexpr size_t m = get_node_len<n>();
+
+  const size_t chunk_len = sphincs_plus_utils::from_be_bytes(header.template subspan<1, 4>());
+  const uint64_t object_len = (static_cast<uint64_t>(sphincs_plus_utils::from_be_bytes(header.template subspan<5, 4>())) << 32) |
+                              static_cast<uint64_t>(sphincs_plus_utils::from_be_bytes(header.template subspan<9, 4>()));
+  const uint32_t depth = header[13];
+
+  if ((header[0] != ROOT_PREFIX) || (chunk_len == 0)) {
+    return false;
+  }
+
+  const size_t chunk_cnt = get_chunk_cnt(object_len, chunk_len);
+  if ((depth != sphincs_plus_merkle::compute_depth(chunk_cnt)) || (chunk_idx >= chunk_cnt) || (proof.size() != depth * m)) {
+    return false;
+  }
+
+  // Each chunk is `chunk_len` -bytes, except possibly the last one
+  const uint64_t off = static_cast<uint64_t>(chunk_idx) * chunk_len;
+  const uint64_t expected_len = std::min<uint64_t>(chunk_len, object_len - off);
+  if (chunk.size() != expected_len) {
+    return false;
+  }
+
+  std::array<uint8_t, m> leaf{};
+  std::array<uint8_t, m> root{};
+
+  sphincs_plus_merkle::hash_leaf<m>(chunk, leaf);
+  sphincs_plus_merkle::root_from_path<m>(leaf, chunk_idx, proof, root);
+
+  auto _root = header.template subspan<14, m>();
+  return std::equal(root.begin(), root.end(), _root.begin());
+}
+
+// Signs object header, produced by `tree_t::get_header`, using 4*n -bytes SPHINCS+ secret key. Randomized signing
+// works same as `sphincs_plus::sign`.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize = false>
+static inline void
+sign(std::span<const uint8_t, get_header_len<n>()> header,
+     std::span<const uint8_t, sphincs_plus_utils::get_sphincs_skey_len<n>()> skey,
+     std::span<const uint8_t, n * randomize> rand_bytes,
+     std::span<uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(header, skey, rand_bytes, sig);
+}
+
+// Verifies a chunk of a signed object, using signed object header, SPHINCS+ signature over it, chunk index, inclusion
+// proof of chunk and 2*n -bytes SPHINCS+ public key, returning truth value in case of successful verification. This
+// routine always verifies SPHINCS+ signature, see `verifier_t` for verifying SPHINCS+ signature once per object.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline bool
+verify_chunk(std::span<const uint8_t, get_header_len<n>()> header,
+             std::span<const uint8_t, sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>()> sig,
+             const size_t chunk_idx,
+             std::span<const uint8_t> chunk,
+             std::span<const uint8_t> proof,
+             std::span<const uint8_t, sphincs_plus_utils::get_sphincs_pkey_len<n>()> pkey)
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+{
+  if (!check_chunk<n>(header, chunk_idx, chunk, proof)) {
+    return false;
+  }
+
+  return sphincs_plus::verify<n, h, d, a, k, w, v>(header, sig, pkey);
+}
+
+// Chunk verifier, bound to a SPHINCS+ public key, which remembers headers of last few objects, whose SPHINCS+
+// signature was successfully verified. So verifying a chunk of an already authenticated object costs log2(# -of chunks)
+// hashes, along with hashing the chunk itself.
+//
+// Verifier is safe to be shared among threads. It keeps at max `capacity` -many headers, evicting the oldest one, when
+// full.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+  requires(sphincs_plus_params::check_sign_verify_params<n, h, d, a, k, w, v>())
+struct verifier_t
+{
+private:
+  static constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  static constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  sphincs_plus_merkle::root_verifier_t<get_header_len<n>(), n, h, d, a, k, w, v> headers;
+
+public:
+  // Constructs a chunk verifier for given 2*n -bytes SPHINCS+ public key, remembering at max `capacity` (>0) -many
+  // authenticated object headers.
+  inline explicit verifier_t(std::span<const uint8_t, pklen> pkey, const size_t capacity = 16)
+    : headers(pkey, capacity)
+  {
+  }
+
+  // Verifies a chunk of a signed object, returning truth value in case of successful verification. SPHINCS+ signature
+  // over object header is verified only if the header is not yet authenticated.
+  inline bool verify_chunk(std::span<const uint8_t, get_header_len<n>()> header,
+                           std::span<const uint8_t, siglen> sig,
+                           const size_t chunk_idx,
+                           std::span<const uint8_t> chunk,
+                           std::span<const uint8_t> proof)
+  {
+    if (!check_chunk<n>(header, chunk_idx, chunk, proof)) {
+      return false;
+    }
+
+    return headers.verify(header, sig);
+  }
+
+  // Returns # -of chunk verifications which didn't require verifying SPHINCS+ signature.
+  inline uint64_t get_hits() const { return headers.get_hits(); }
+
+  // Returns # -of chunk verifications which required verifying SPHINCS+ signature.
+  inline uint64_t get_misses() const { return headers.get_misses(); }
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "address.hpp"
 #include "hashing.hpp"
+#include "utils.hpp"
 #include <array>
 
 // One-Time Signature scheme WOTS+, used in SPHINCS+
@@ -33,14 +34,204 @@ chain(std::span<const uint8_t, n> x,
   std::copy(x.begin(), x.end(), chained.begin());
   std::array<uint8_t, n> tmp{};
 
-  for (uint32_t i = s_idx; i < till; i++) {
-    adrs.set_hash_address(i);
+  // Input prefix of F ( = pk_seed || ADRS ) is serialized once, while only hash
+  // address is rewritten, on each step of the chain
+  std::array<uint8_t, n + sphincs_plus_adrs::ADRS_BYTE_WIDTH> prefix{};
+  auto _prefix = std::span(prefix);
+  auto _adrs = _prefix.template subspan<n, sphincs_plus_adrs::ADRS_BYTE_WIDTH>();
+
+  adrs.set_hash_address(s_idx);
+
+  std::copy(pk_seed.begin(), pk_seed.end(), _prefix.template subspan<0, n>().begin());
+  adrs.to_bytes(_adrs);
 
-    sphincs_plus_hashing::f<n, v>(pk_seed, adrs.data, chained, tmp);
+  for (uint32_t i = s_idx; i < till; i++) {
+    sphincs_plus_hashing::t_l_prefixed<n, 1, v>(_prefix, chained, tmp);
     std::copy(tmp.begin(), tmp.end(), chained.begin());
+
+    adrs.inc_hash_address();
+    adrs.template word_to_bytes<7>(_adrs);
+  }
+}
+
+// Occupancy of lanes, while WOTS+ chains are walked together by `chain_lanes`.
+struct lane_stats_t
+{
+  uint64_t rounds = 0; // # -of rounds, each applying F on all busy lanes
+  uint64_t busy = 0;   // # -of F calls, summed over all rounds
+
+  // Returns fraction of lane slots doing useful work, over all rounds.
+  inline double get_occupancy() const
+  {
+    const uint64_t slots = rounds * static_cast<uint64_t>(sphincs_plus_hashing::F_LANES);
+    return slots == 0 ? 0. : static_cast<double>(busy) / static_cast<double>(slots);
+  }
+};
+
+// Given len -many n -bytes chain inputs ( living contiguously ), with i -th
+// chain starting at base-w digit `s_idxs[i]`, this routine walks all chains
+// till their end i.e. position w - 1, writing len * n -bytes chain outputs,
+// same as calling `chain` for each of them.
+//
+// Chains are of uneven length, so instead of walking them one after another,
+// they are packed into `F_LANES` -many lanes, each round applying F on every
+// busy lane, using `f_batch`. As soon as a chain finishes, its lane picks up
+// next pending chain. Pending chains are taken longest first, so that lanes
+// stay busy till the very end. Optionally, lane occupancy is accumulated into
+// `stats`.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v, size_t len>
+static inline void
+chain_lanes(std::span<const uint8_t, n * len> xs,
+            std::span<const uint8_t, len> s_idxs,
+            sphincs_plus_adrs::wots_hash_t adrs,
+            std::span<const uint8_t, n> pk_seed,
+            std::span<uint8_t, n * len> chained,
+            lane_stats_t* const stats = nullptr)
+  requires(sphincs_plus_params::check_w(w))
+{
+  constexpr size_t lanes = sphincs_plus_hashing::F_LANES;
+
+  std::copy(xs.begin(), xs.end(), chained.begin());
+
+  // Chains, ordered by # -of remaining steps, longest first, using counting sort
+  // on starting base-w digit, which, unlike `std::stable_sort`, doesn't allocate.
+  std::array<uint16_t, w + 1> offs{};
+  std::array<uint16_t, len> order{};
+
+  for (size_t i = 0; i < len; i++) {
+    offs[s_idxs[i] + 1]++;
+  }
+  for (size_t i = 1; i <= w; i++) {
+    offs[i] += offs[i - 1];
+  }
+  for (size_t i = 0; i < len; i++) {
+    order[offs[s_idxs[i]]++] = static_cast<uint16_t>(i);
+  }
+
+  // Chain being walked by each lane, along with its current position
+  std::array<uint16_t, lanes> lane_chain{};
+  std::array<uint32_t, lanes> lane_pos{};
+  std::array<bool, lanes> lane_busy{};
+
+  std::array<sphincs_plus_adrs::adrs_t, lanes> adrses{};
+  std::array<uint8_t, lanes * n> msgs{};
+  std::array<uint8_t, lanes * n> digs{};
+
+  auto _adrses = std::span<const sphincs_plus_adrs::adrs_t, lanes>(adrses);
+  auto _msgs = std::span(msgs);
+  auto _digs = std::span(digs);
+
+  size_t next = 0;
+  size_t busy_cnt = 0;
+
+  // Puts next pending chain, which requires at least one F call, on lane `l`
+  auto refill = [&](const size_t l) {
+    while ((next < len) && (static_cast<size_t>(s_idxs[order[next]]) >= (w - 1))) {
+      next++;
+    }
+
+    lane_busy[l] = next < len;
+    if (lane_busy[l]) {
+      lane_chain[l] = order[next];
+      lane_pos[l] = static_cast<uint32_t>(s_idxs[order[next]]);
+
+      next++;
+      busy_cnt++;
+    }
+  };
+
+  for (size_t l = 0; l < lanes; l++) {
+    refill(l);
+  }
+
+  while (busy_cnt > 0) {
+    for (size_t l = 0; l < lanes; l++) {
+      if (!lane_busy[l]) {
+        continue;
+      }
+
+      const size_t off = static_cast<size_t>(lane_chain[l]) * n;
+      auto limb = chained.subspan(off, n);
+
+      adrs.set_chain_address(lane_chain[l]);
+      adrs.set_hash_address(lane_pos[l]);
+
+      adrses[l] = adrs;
+      std::copy(limb.begin(), limb.end(), _msgs.subspan(l * n, n).begin());
+    }
+
+    if (busy_cnt == lanes) {
+      sphincs_plus_hashing::f_batch<n, v, lanes>(pk_seed, _adrses, _msgs, _digs);
+    } else {
+      for (size_t l = 0; l < lanes; l++) {
+        if (lane_busy[l]) {
+          sphincs_plus_hashing::f<n, v>(pk_seed,
+                                        adrses[l],
+                                        std::span<const uint8_t, n>(_msgs.subspan(l * n, n)),
+                                        std::span<uint8_t, n>(_digs.subspan(l * n, n)));
+        }
+      }
+    }
+
+    if (stats != nullptr) {
+      stats->rounds++;
+      stats->busy += busy_cnt;
+    }
+
+    for (size_t l = 0; l < lanes; l++) {
+      if (!lane_busy[l]) {
+        continue;
+      }
+
+      const size_t off = static_cast<size_t>(lane_chain[l]) * n;
+      auto dig = _digs.subspan(l * n, n);
+
+      std::copy(dig.begin(), dig.end(), chained.subspan(off, n).begin());
+      lane_pos[l]++;
+
+      if (static_cast<size_t>(lane_pos[l]) == (w - 1)) {
+        busy_cnt--;
+        refill(l);
+      }
+    }
   }
 }
 
+// Given n -bytes message, this routine computes len -many base-w digits, which
+// are len1 -many base-w digits of message, followed by len2 -many base-w digits
+// of its checksum, as described in algorithm 5 of section 3.5 of SPHINCS+
+// specification https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// i-th digit denotes # -of times F is applied on i-th secret key limb, for
+// producing i-th limb of WOTS+ signature.
+template<size_t n, size_t w>
+static inline void
+compute_digits(std::span<const uint8_t, n> msg, std::span<uint8_t, sphincs_plus_utils::compute_wots_len<n, w>()> digits)
+{
+  constexpr size_t lgw = sphincs_plus_utils::log2<w>();
+  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
+  constexpr size_t len2 = sphincs_plus_utils::compute_wots_len2<n, w, len1>();
+
+  uint32_t csum = 0;
+
+  sphincs_plus_utils::base_w<w, n, len1>(msg, digits.template subspan<0, len1>());
+
+  for (size_t i = 0; i < len1; i++) {
+    csum += static_cast<uint32_t>(w - 1ul) - static_cast<uint32_t>(digits[i]);
+  }
+
+  if constexpr (((len2 * lgw) & 7ul) != 0) {
+    csum <<= (8ul - ((len2 * lgw) & 7ul));
+  }
+
+  constexpr size_t t0 = len2 * lgw;
+  constexpr size_t t1 = t0 + 7ul;
+  constexpr size_t len_2_bytes = t1 >> 3; // = ceil(t0 / 8)
+
+  const auto bytes = sphincs_plus_utils::to_byte<len_2_bytes>(csum);
+  sphincs_plus_utils::base_w<w, len_2_bytes, len2>(bytes, digits.template subspan<len1, len2>());
+}
+
 // Generates n -bytes WOTS+ compressed public key, given n -bytes secret key
 // seed, n -bytes public key seed and 32 -bytes WOTS+ hash address, using
 // algorithm 4 defined in section 3.4 of SPHINCS+ specification
@@ -67,7 +258,7 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
     sk_adrs.set_chain_address(i);
     sk_adrs.set_hash_address();
 
-    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, sk_adrs.data, sk_limb);
+    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, sk_adrs, sk_limb);
 
     adrs.set_chain_address(i);
     adrs.set_hash_address(0);
@@ -78,7 +269,7 @@ pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed,
   pk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PK);
   pk_adrs.set_keypair_address(adrs.get_keypair_address());
 
-  sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs.data, chain_limbs, pkey);
+  sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs, chain_limbs, pkey);
 }
 
 // Generates n * len -bytes WOTS+ signature, given n -bytes message, n -bytes
@@ -93,54 +284,91 @@ sign(std::span<const uint8_t, n> msg,
      sphincs_plus_adrs::wots_hash_t adrs,
      std::span<uint8_t, n * sphincs_plus_utils::compute_wots_len<n, w>()> sig)
 {
-  constexpr size_t lgw = sphincs_plus_utils::log2<w>();
-  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
-  constexpr size_t len2 = sphincs_plus_utils::compute_wots_len2<n, w, len1>();
-  constexpr size_t len = len1 + len2;
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
   static_assert(sig.size() == len * n, "Ensure that WOTS+ signature size is correctly computed !");
 
-  uint32_t csum = 0;
-  std::array<uint8_t, sig.size()> tmp{};
+  std::array<uint8_t, len> tmp{};
   auto _tmp = std::span(tmp);
 
-  sphincs_plus_utils::base_w<w, n, len1>(msg, _tmp.template subspan<0, len1>());
+  compute_digits<n, w>(msg, _tmp);
 
-  for (size_t i = 0; i < len1; i++) {
-    csum += static_cast<uint32_t>(w - 1ul) - static_cast<uint32_t>(tmp[i]);
-  }
+  sphincs_plus_adrs::wots_prf_t sk_adrs{ adrs };
 
-  if constexpr ((lgw & 7ul) != 0) {
-    csum <<= (8ul - ((len2 * lgw) & 7ul));
+  sk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PRF);
+  sk_adrs.set_keypair_address(adrs.get_keypair_address());
+
+  std::array<uint8_t, n> sk{};
+
+  for (uint32_t i = 0; i < static_cast<uint32_t>(len); i++) {
+    const size_t off = static_cast<size_t>(i) * n;
+
+    sk_adrs.set_chain_address(i);
+    sk_adrs.set_hash_address();
+
+    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, sk_adrs, sk);
+
+    adrs.set_chain_address(i);
+    adrs.set_hash_address(0);
+
+    const uint32_t steps = static_cast<uint32_t>(_tmp[i]);
+    chain<n, w, v>(sk, 0u, steps, adrs, pk_seed, std::span<uint8_t, n>(sig.subspan(off, n)));
   }
+}
 
-  constexpr size_t t0 = len2 * lgw;
-  constexpr size_t t1 = t0 + 7ul;
-  constexpr size_t len_2_bytes = t1 >> 3; // = ceil(t0 / 8)
+// Generates n -bytes WOTS+ compressed public key and n * len -bytes WOTS+
+// signature over n -bytes message, at once, given n -bytes secret key seed,
+// n -bytes public key seed and 32 -bytes WOTS+ hash address.
+//
+// While walking each chain, from secret key limb to public key limb ( see
+// `pkgen` ), the intermediate value at message's base-w digit position is
+// captured as signature limb ( see `sign` ), so that neither PRF nor chain
+// prefix is recomputed. Output is same as calling `pkgen` and `sign`.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+pkgen_and_sign(std::span<const uint8_t, n> msg,
+               std::span<const uint8_t, n> sk_seed,
+               std::span<const uint8_t, n> pk_seed,
+               sphincs_plus_adrs::wots_hash_t adrs,
+               std::span<uint8_t, n> pkey,
+               std::span<uint8_t, n * sphincs_plus_utils::compute_wots_len<n, w>()> sig)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
 
-  const auto bytes = sphincs_plus_utils::to_byte<len_2_bytes>(csum);
-  sphincs_plus_utils::base_w<w, len_2_bytes, len2>(bytes, _tmp.template subspan<len1, len2>());
+  std::array<uint8_t, len> digits{};
+  compute_digits<n, w>(msg, digits);
 
+  sphincs_plus_adrs::wots_pk_t pk_adrs{ adrs };
   sphincs_plus_adrs::wots_prf_t sk_adrs{ adrs };
 
   sk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PRF);
   sk_adrs.set_keypair_address(adrs.get_keypair_address());
 
-  std::array<uint8_t, n> sk{};
+  std::array<uint8_t, n> sk_limb{};
+  std::array<uint8_t, n * len> chain_limbs{};
+  auto _chain_limbs = std::span(chain_limbs);
 
   for (uint32_t i = 0; i < static_cast<uint32_t>(len); i++) {
     const size_t off = static_cast<size_t>(i) * n;
+    const uint32_t steps = static_cast<uint32_t>(digits[i]);
 
     sk_adrs.set_chain_address(i);
     sk_adrs.set_hash_address();
 
-    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, sk_adrs.data, sk);
+    sphincs_plus_hashing::prf<n>(pk_seed, sk_seed, sk_adrs, sk_limb);
 
     adrs.set_chain_address(i);
     adrs.set_hash_address(0);
 
-    const uint32_t steps = static_cast<uint32_t>(_tmp[i]);
-    chain<n, w, v>(sk, 0u, steps, adrs, pk_seed, std::span<uint8_t, n>(sig.subspan(off, n)));
+    auto sig_limb = std::span<uint8_t, n>(sig.subspan(off, n));
+
+    chain<n, w, v>(sk_limb, 0u, steps, adrs, pk_seed, sig_limb);
+    chain<n, w, v>(sig_limb, steps, static_cast<uint32_t>(w - 1) - steps, adrs, pk_seed, std::span<uint8_t, n>(_chain_limbs.subspan(off, n)));
   }
+
+  pk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PK);
+  pk_adrs.set_keypair_address(adrs.get_keypair_address());
+
+  sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs, chain_limbs, pkey);
 }
 
 // Computes n -bytes WOTS+ compressed public key from n -bytes message and
@@ -148,61 +376,37 @@ sign(std::span<const uint8_t, n> msg,
 // hash address is also provided, using algorithm 6, defined in section 3.6 of
 // SPHINCS+ specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// Uneven chains are walked together, see `chain_lanes`, optionally accumulating
+// lane occupancy into `stats`.
 template<size_t n, size_t w, sphincs_plus_hashing::variant v>
 static inline void
 pk_from_sig(std::span<const uint8_t, n * sphincs_plus_utils::compute_wots_len<n, w>()> sig,
             std::span<const uint8_t, n> msg,
             std::span<const uint8_t, n> pk_seed,
             sphincs_plus_adrs::wots_hash_t adrs,
-            std::span<uint8_t, n> pkey)
+            std::span<uint8_t, n> pkey,
+            lane_stats_t* const stats = nullptr)
 {
-  constexpr size_t lgw = sphincs_plus_utils::log2<w>();
-  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
-  constexpr size_t len2 = sphincs_plus_utils::compute_wots_len2<n, w, len1>();
-  constexpr size_t len = len1 + len2;
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
   static_assert(sig.size() == len * n, "Ensure that WOTS+ signature size is correctly computed !");
 
   sphincs_plus_adrs::wots_pk_t pk_adrs{ adrs };
 
-  uint32_t csum = 0;
-  std::array<uint8_t, sig.size()> tmp0{};
+  std::array<uint8_t, len> tmp0{};
   auto _tmp0 = std::span(tmp0);
 
-  sphincs_plus_utils::base_w<w, n, len1>(msg, _tmp0.template subspan<0, len1>());
-
-  for (size_t i = 0; i < len1; i++) {
-    csum += static_cast<uint32_t>(w - 1ul) - static_cast<uint32_t>(_tmp0[i]);
-  }
-
-  if constexpr ((lgw & 7ul) != 0) {
-    csum <<= (8ul - ((len2 * lgw) & 7ul));
-  }
-
-  constexpr size_t t0 = len2 * lgw;
-  constexpr size_t t1 = t0 + 7ul;
-  constexpr size_t len_2_bytes = t1 >> 3; // = ceil(t0 / 8)
-
-  const auto bytes = sphincs_plus_utils::to_byte<len_2_bytes>(csum);
-  sphincs_plus_utils::base_w<w, len_2_bytes, len2>(bytes, _tmp0.template subspan<len1, len2>());
+  compute_digits<n, w>(msg, _tmp0);
 
   std::array<uint8_t, n * len> tmp1{};
   auto _tmp1 = std::span(tmp1);
 
-  for (uint32_t i = 0; i < static_cast<uint32_t>(len); i++) {
-    const size_t off = static_cast<size_t>(i) * n;
-
-    adrs.set_chain_address(i);
-    adrs.set_hash_address(0);
-
-    const uint32_t sidx = static_cast<uint32_t>(_tmp0[i]);
-    const uint32_t steps = static_cast<uint32_t>((w - 1) - _tmp0[i]);
-    chain<n, w, v>(std::span<const uint8_t, n>(sig.subspan(off, n)), sidx, steps, adrs, pk_seed, std::span<uint8_t, n>(_tmp1.subspan(off, n)));
-  }
+  chain_lanes<n, w, v, len>(sig, _tmp0, adrs, pk_seed, _tmp1, stats);
 
   pk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PK);
   pk_adrs.set_keypair_address(adrs.get_keypair_address());
 
-  sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs.data, _tmp1, pkey);
+  sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs, _tmp1, pkey);
 }
 
 }
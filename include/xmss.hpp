@@ -1,6 +1,7 @@
 #pragma once
 #include "wots.hpp"
-#include <stack>
+#include <algorithm>
+#include <cassert>
 
 // Fixed Input-Length XMSS, used in SPHINCS+
 namespace sphincs_plus_xmss {
@@ -19,45 +20,187 @@ struct node_t
   constexpr node_t<n>() = default;
 };
 
+// Fixed-capacity stack of at max `cap` -many tree nodes, living in place, used
+// by treehash variants instead of `std::stack`, which allocates on heap.
+template<size_t n, size_t cap>
+struct node_stack_t
+{
+private:
+  std::array<node_t<n>, cap> nodes{};
+  size_t cnt = 0;
+
+public:
+  inline bool empty() const { return cnt == 0; }
+  inline const node_t<n>& top() const { return nodes[cnt - 1]; }
+  inline void pop() { cnt--; }
+
+  inline void push(const node_t<n>& node)
+  {
+    assert(cnt < cap);
+    nodes[cnt++] = node;
+  }
+};
+
+// Max height of subtree, whose nodes are computed level by level, in a flat
+// array, by `level_treehash`.
+constexpr uint32_t LEVEL_HEIGHT = 6u;
+
+// Max height of any ( sub )tree, computed by treehash variants, as leaf indices
+// are 4 -bytes wide.
+constexpr uint32_t MAX_TREE_HEIGHT = 32u;
+
+// Caller-supplied scratch space, holding nodes of a subtree of height
+// `LEVEL_HEIGHT`, computed by `level_treehash`. Keeping it off the call stack
+// lets key generation and signing run on threads with small stacks, while
+// reusing it across calls keeps it warm in cache.
+template<size_t n>
+struct workspace_t
+{
+  std::array<uint8_t, ((2u << LEVEL_HEIGHT) - 1u) * n> nodes{};
+};
+
+// Computes all `p_nodes.size() / n` -many n -bytes parent nodes, at height
+// `height` of a binary hash tree, from their children, living contiguously in
+// `c_nodes`, s.t. leftmost parent node is at index `s_idx` of that level.
+// Sibling pairs are hashed `H_LANES` at a time, using `h_batch`.
+//
+// Address type is either of XMSS tree address or FORS tree address, both of
+// them encoding tree height and index in same way.
+template<size_t n, sphincs_plus_hashing::variant v, typename adrs_type>
+static inline void
+hash_level(std::span<const uint8_t, n> pk_seed,
+           adrs_type adrs,
+           const uint32_t height,
+           const uint32_t s_idx,
+           std::span<const uint8_t> c_nodes,
+           std::span<uint8_t> p_nodes)
+{
+  constexpr size_t lanes = sphincs_plus_hashing::H_LANES;
+  const size_t node_cnt = p_nodes.size() / n;
+
+  std::array<sphincs_plus_adrs::adrs_t, lanes> adrses{};
+  auto _adrses = std::span<const sphincs_plus_adrs::adrs_t, lanes>(adrses);
+
+  adrs.set_tree_height(height);
+  adrs.set_tree_index(s_idx);
+
+  size_t i = 0;
+  for (; i + lanes <= node_cnt; i += lanes) {
+    for (size_t l = 0; l < lanes; l++) {
+      adrses[l] = adrs;
+      adrs.inc_tree_index();
+    }
+
+    sphincs_plus_hashing::h_batch<n, v, lanes>(pk_seed,
+                                               _adrses,
+                                               std::span<const uint8_t, lanes * 2 * n>(c_nodes.subspan(i * 2 * n, lanes * 2 * n)),
+                                               std::span<uint8_t, lanes * n>(p_nodes.subspan(i * n, lanes * n)));
+  }
+
+  for (; i < node_cnt; i++, adrs.inc_tree_index()) {
+    sphincs_plus_hashing::h<n, v>(pk_seed,
+                                  adrs,
+                                  std::span<const uint8_t, 2 * n>(c_nodes.subspan(i * 2 * n, 2 * n)),
+                                  std::span<uint8_t, n>(p_nodes.subspan(i * n, n)));
+  }
+}
+
 // Computes n -bytes root node of a subtree of height `n_height` with leftmost
-// leaf node being WOTS+ compressed public key at index `s_idx`, using algorithm
-// 7, described in section 4.1.3 of SPHINCS+ specification
+// leaf node at index `s_idx`, where i -th leaf node is computed by calling
+// `leaf(s_idx + i, span<uint8_t, n>)`, producing same root as algorithm 7,
+// described in section 4.1.3 of SPHINCS+ specification
 // https://sphincs.org/data/sphincs+-r3.1-specification.pdf
-template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+//
+// Instead of hashing one node at a time, as soon as two siblings are available,
+// subtree is split into subtrees of height min(n_height, LEVEL_HEIGHT), each
+// computed level by level, in a contiguous node array, where all leaves are
+// computed first and then all sibling pairs of a level are hashed together,
+// see `hash_level`. Roots of those subtrees are then merged using a stack, same
+// as algorithm 7 does.
+//
+// Nodes of each subtree are kept in `ws`, when supplied, else on stack.
+//
+// Optionally, n_height * n -bytes authentication path of leaf at index `p_idx`
+// can be requested, in which case its j -th node is copied to `path`, as soon as
+// that node is computed, either from level j of node array of a subtree or
+// while merging roots of subtrees.
+template<size_t n, sphincs_plus_hashing::variant v, typename adrs_type, typename leaf_fn>
 static inline void
-treehash(std::span<const uint8_t, n> sk_seed,
-         const uint32_t s_idx,
-         const uint32_t n_height,
-         std::span<const uint8_t, n> pk_seed,
-         const sphincs_plus_adrs::adrs_t adrs,
-         std::span<uint8_t, n> root)
+level_treehash(std::span<const uint8_t, n> pk_seed,
+               const uint32_t s_idx,
+               const uint32_t n_height,
+               adrs_type adrs,
+               leaf_fn&& leaf,
+               std::span<uint8_t, n> root,
+               workspace_t<n>* const ws = nullptr,
+               std::span<uint8_t> path = {},
+               const uint32_t p_idx = 0u)
 {
-  // # -of leafs in the subtree
-  const uint32_t leaf_cnt = 1u << n_height;
-  // Stack which will hold at max `n_height` many intermediate nodes
-  std::stack<node_t<n>> stack;
+  if (ws == nullptr) {
+    workspace_t<n> ws_{};
+    level_treehash<n, v>(pk_seed, s_idx, n_height, adrs, leaf, root, &ws_, path, p_idx);
+    return;
+  }
 
-  for (uint32_t i = 0; i < leaf_cnt; i++) {
-    sphincs_plus_adrs::wots_hash_t hash_adrs{ adrs };
+  assert(n_height < MAX_TREE_HEIGHT);
+  assert(path.empty() || (path.size() == static_cast<size_t>(n_height) * n));
 
-    hash_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
-    hash_adrs.set_keypair_address(s_idx + i);
+  // Copies node at height j and index `idx`, if it's sibling of j -th ancestor of leaf `p_idx`
+  auto capture = [&](const uint32_t j, const uint32_t idx, std::span<const uint8_t> node) {
+    if (!path.empty() && (j < n_height) && (idx == ((p_idx >> j) ^ 1u))) {
+      std::copy_n(node.begin(), n, path.subspan(j * n, n).begin());
+    }
+  };
 
-    node_t<n> node{};
-    sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, hash_adrs, node.data);
-    node.height = 1u;
+  const uint32_t s_height = std::min(n_height, LEVEL_HEIGHT);
+  const uint32_t s_leaf_cnt = 1u << s_height;
+  const uint32_t s_cnt = 1u << (n_height - s_height);
 
-    sphincs_plus_adrs::tree_t tree_adrs{ adrs };
+  // Flat array holding all nodes of a subtree, level by level, starting with leaves
+  auto _nodes = std::span(ws->nodes);
 
-    tree_adrs.set_type(sphincs_plus_adrs::type_t::TREE);
-    tree_adrs.set_tree_height(1u);
-    tree_adrs.set_tree_index(s_idx + i);
+  // Stack holding at max `n_height - s_height + 1` many roots of subtrees
+  node_stack_t<n, MAX_TREE_HEIGHT - LEVEL_HEIGHT + 1u> stack;
 
-    // Two consecutive nodes, each of n -bytes width
-    //
-    // Used for computing parent node of binary Merkle Tree, from two children
-    std::array<uint8_t, n + n> c_nodes{};
-    auto _c_nodes = std::span(c_nodes);
+  // Two consecutive nodes, each of n -bytes width
+  //
+  // Used for computing parent node of binary hash tree, from two children
+  std::array<uint8_t, n + n> c_nodes{};
+  auto _c_nodes = std::span(c_nodes);
+
+  for (uint32_t s = 0; s < s_cnt; s++) {
+    const uint32_t l_idx = s_idx + (s << s_height);
+
+    for (uint32_t i = 0; i < s_leaf_cnt; i++) {
+      leaf(l_idx + i, std::span<uint8_t, n>(_nodes.subspan(i * n, n)));
+    }
+
+    size_t coff = 0;
+    for (uint32_t j = 0; j < s_height; j++) {
+      const size_t node_cnt = s_leaf_cnt >> (j + 1u);
+      const size_t poff = coff + (node_cnt << 1) * n;
+
+      hash_level<n, v>(pk_seed, adrs, j + 1u, l_idx >> (j + 1u), _nodes.subspan(coff, (node_cnt << 1) * n), _nodes.subspan(poff, node_cnt * n));
+      coff = poff;
+    }
+
+    // Authentication path nodes, below height `s_height`, are all in node array of the subtree holding leaf `p_idx`
+    if (!path.empty() && ((p_idx >> s_height) == (l_idx >> s_height))) {
+      size_t loff = 0;
+      for (uint32_t j = 0; j < s_height; j++) {
+        const uint32_t k = ((p_idx >> j) ^ 1u) - (l_idx >> j);
+
+        capture(j, (p_idx >> j) ^ 1u, _nodes.subspan(loff + static_cast<size_t>(k) * n, n));
+        loff += static_cast<size_t>(s_leaf_cnt >> j) * n;
+      }
+    }
+
+    node_t<n> node{};
+    std::copy_n(_nodes.subspan(coff, n).begin(), n, node.data.begin());
+    node.height = s_height;
+
+    uint32_t idx = l_idx >> s_height;
+    capture(node.height, idx, node.data);
 
     while (!stack.empty()) {
       const auto top = stack.top();
@@ -65,15 +208,17 @@ treehash(std::span<const uint8_t, n> sk_seed,
         break;
       }
 
-      tree_adrs.set_tree_index((tree_adrs.get_tree_index() - 1u) >> 1);
+      idx >>= 1;
+      adrs.set_tree_height(node.height + 1u);
+      adrs.set_tree_index(idx);
 
       std::copy(top.data.begin(), top.data.end(), _c_nodes.template subspan<0, n>().begin());
       std::copy(node.data.begin(), node.data.end(), _c_nodes.template subspan<n, n>().begin());
 
-      sphincs_plus_hashing::h<n, v>(pk_seed, tree_adrs.data, _c_nodes, node.data);
-      node.height = tree_adrs.get_tree_height() + 1u;
+      sphincs_plus_hashing::h<n, v>(pk_seed, adrs, _c_nodes, node.data);
+      node.height++;
+      capture(node.height, idx, node.data);
 
-      tree_adrs.set_tree_height(tree_adrs.get_tree_height() + 1u);
       stack.pop();
     }
 
@@ -82,7 +227,39 @@ treehash(std::span<const uint8_t, n> sk_seed,
 
   const node_t<n> top = stack.top();
   std::copy(top.data.begin(), top.data.end(), root.begin());
-  stack.pop(); // Drop root of XMSS Tree, stack is empty now.
+  stack.pop(); // Drop root of subtree, stack is empty now.
+}
+
+// Computes n -bytes root node of a subtree of height `n_height` with leftmost
+// leaf node being WOTS+ compressed public key at index `s_idx`, using algorithm
+// 7, described in section 4.1.3 of SPHINCS+ specification
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// Nodes are computed level by level, see `level_treehash`, optionally using
+// caller-supplied workspace.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+treehash(std::span<const uint8_t, n> sk_seed,
+         const uint32_t s_idx,
+         const uint32_t n_height,
+         std::span<const uint8_t, n> pk_seed,
+         const sphincs_plus_adrs::adrs_t adrs,
+         std::span<uint8_t, n> root,
+         workspace_t<n>* const ws = nullptr)
+{
+  sphincs_plus_adrs::tree_t tree_adrs{ adrs };
+  tree_adrs.set_type(sphincs_plus_adrs::type_t::TREE);
+
+  auto leaf = [&](const uint32_t idx, std::span<uint8_t, n> node) {
+    sphincs_plus_adrs::wots_hash_t hash_adrs{ adrs };
+
+    hash_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+    hash_adrs.set_keypair_address(idx);
+
+    sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, hash_adrs, node);
+  };
+
+  level_treehash<n, v>(pk_seed, s_idx, n_height, tree_adrs, leaf, root, ws);
 }
 
 // Computes XMSS public key, which is the n -bytes root of the binary hash tree,
@@ -90,9 +267,191 @@ treehash(std::span<const uint8_t, n> sk_seed,
 // specification https://sphincs.org/data/sphincs+-r3.1-specification.pdf
 template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
 static inline void
-pkgen(std::span<const uint8_t, n> sk_seed, std::span<const uint8_t, n> pk_seed, const sphincs_plus_adrs::adrs_t adrs, std::span<uint8_t, n> pkey)
+pkgen(std::span<const uint8_t, n> sk_seed,
+      std::span<const uint8_t, n> pk_seed,
+      const sphincs_plus_adrs::adrs_t adrs,
+      std::span<uint8_t, n> pkey,
+      workspace_t<n>* const ws = nullptr)
+{
+  treehash<n, w, v>(sk_seed, 0u, h, pk_seed, adrs, pkey, ws);
+}
+
+// Compile-time compute byte length of flat node array, holding all nodes of an
+// XMSS tree of height h, where each node is n -bytes wide.
+template<uint32_t h, size_t n>
+static inline constexpr size_t
+get_tree_len()
+{
+  return ((2ul << h) - 1ul) * n;
+}
+
+// Request for n * len -bytes WOTS+ signature, over n -bytes message, using
+// WOTS+ keypair at leaf index `idx` of an XMSS tree, which is to be produced
+// while that leaf is being computed, see `build_tree`.
+template<size_t n, size_t w>
+struct leaf_sig_t
+{
+  uint32_t idx = 0u;
+  std::span<const uint8_t, n> msg;
+  std::span<uint8_t, sphincs_plus_utils::compute_wots_len<n, w>() * n> sig;
+};
+
+// Computes all nodes of XMSS tree of height h, writing them to flat node array,
+// level by level, starting with 2^h leaves ( i.e. WOTS+ compressed public keys )
+// and ending with n -bytes root s.t. node at height j and index i lives at
+// offset ((2^(h+1) - 2^(h+1-j)) + i) * n. Tree nodes are same as the ones
+// computed by algorithm 7, described in section 4.1.3 of SPHINCS+ specification
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// Optionally, WOTS+ signatures can be requested ( sorted by leaf index ), which
+// are produced while computing respective leaves, so that WOTS+ secret key
+// limbs and chain prefixes are computed only once. Whole tree is useful when
+// many signatures need to be produced from same XMSS instance, see
+// `auth_path_from_tree`.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+build_tree(std::span<const uint8_t, n> sk_seed,
+           std::span<const uint8_t, n> pk_seed,
+           const sphincs_plus_adrs::adrs_t adrs,
+           std::span<uint8_t, get_tree_len<h, n>()> nodes,
+           std::span<const leaf_sig_t<n, w>> reqs = {})
+{
+  constexpr uint32_t leaf_cnt = 1u << h;
+
+  size_t ridx = 0;
+  for (uint32_t i = 0; i < leaf_cnt; i++) {
+    sphincs_plus_adrs::wots_hash_t hash_adrs{ adrs };
+
+    hash_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+    hash_adrs.set_keypair_address(i);
+
+    auto leaf = std::span<uint8_t, n>(nodes.subspan(i * n, n));
+
+    if ((ridx < reqs.size()) && (reqs[ridx].idx == i)) {
+      const auto& req = reqs[ridx++];
+      sphincs_plus_wots::pkgen_and_sign<n, w, v>(req.msg, sk_seed, pk_seed, hash_adrs, leaf, req.sig);
+
+      // Other requests for same leaf may have same message, in which case signature is just copied
+      while ((ridx < reqs.size()) && (reqs[ridx].idx == i)) {
+        const auto& req_ = reqs[ridx++];
+
+        if (std::equal(req_.msg.begin(), req_.msg.end(), req.msg.begin())) {
+          std::copy(req.sig.begin(), req.sig.end(), req_.sig.begin());
+        } else {
+          sphincs_plus_wots::sign<n, w, v>(req_.msg, sk_seed, pk_seed, hash_adrs, req_.sig);
+        }
+      }
+    } else {
+      sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, hash_adrs, leaf);
+    }
+  }
+
+  sphincs_plus_adrs::tree_t tree_adrs{ adrs };
+  tree_adrs.set_type(sphincs_plus_adrs::type_t::TREE);
+
+  size_t coff = 0;
+  for (uint32_t j = 0; j < h; j++) {
+    const uint32_t node_cnt = leaf_cnt >> (j + 1u);
+    const size_t poff = coff + (static_cast<size_t>(node_cnt) << 1) * n;
+
+    hash_level<n, v>(pk_seed, tree_adrs, j + 1u, 0u, nodes.subspan(coff, (static_cast<size_t>(node_cnt) << 1) * n), nodes.subspan(poff, node_cnt * n));
+    coff = poff;
+  }
+}
+
+// Copies h * n -bytes authentication path of leaf at index `idx`, from all nodes
+// of the XMSS tree, already computed using `build_tree`.
+template<uint32_t h, size_t n>
+static inline void
+auth_path_from_tree(const uint32_t idx, std::span<const uint8_t, get_tree_len<h, n>()> nodes, std::span<uint8_t, h * n> path)
+{
+  size_t loff = 0;
+  for (uint32_t j = 0; j < h; j++) {
+    const uint32_t k = (idx >> j) ^ 1u;
+    auto node = nodes.subspan(loff + static_cast<size_t>(k) * n, n);
+
+    std::copy(node.begin(), node.end(), path.subspan(j * n, n).begin());
+    loff += (static_cast<size_t>(1u << h) >> j) * n;
+  }
+}
+
+// Computes (len * n + h * n) -bytes XMSS signature, for n -bytes message, same
+// as `sign`, but copying authentication path from all nodes of the XMSS tree,
+// already computed using `build_tree`, instead of recomputing them.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+sign_from_tree(std::span<const uint8_t, n> msg,
+               std::span<const uint8_t, n> sk_seed,
+               const uint32_t idx,
+               std::span<const uint8_t, n> pk_seed,
+               const sphincs_plus_adrs::adrs_t adrs,
+               std::span<const uint8_t, get_tree_len<h, n>()> nodes,
+               std::span<uint8_t, sphincs_plus_utils::compute_wots_len<n, w>() * n + h * n> sig)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t off0 = 0ul;
+  constexpr size_t off1 = off0 + len * n;
+
+  auth_path_from_tree<h, n>(idx, nodes, sig.template subspan<off1, h * n>());
+
+  sphincs_plus_adrs::wots_hash_t wots_adrs{ adrs };
+
+  wots_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+  wots_adrs.set_keypair_address(idx);
+
+  sphincs_plus_wots::sign<n, w, v>(msg, sk_seed, pk_seed, wots_adrs, sig.template subspan<off0, off1 - off0>());
+}
+
+// Computes (len * n + h * n) -bytes XMSS signature, for n -bytes message, along
+// with n -bytes root of the XMSS tree, in a single pass over all 2^h leaves,
+// using n -bytes secret key seed, 4 -bytes WOTS+ keypair index, n -bytes public
+// key seed & 32 -bytes address, encapsulating which XMSS instance we're using.
+//
+// Tree is computed level by level, same as `treehash` does ( see
+// `level_treehash` ), while WOTS+ signature is produced along with leaf at index
+// `idx`, using `pkgen_and_sign`, and authentication path is copied from stored
+// levels of node array, as nodes get computed. Output is same as calling `sign`
+// followed by `pk_from_sig`, see algorithm 9 and 10, described in section 4.1.6
+// and 4.1.7 of SPHINCS+ specification
+// https://sphincs.org/data/sphincs+-r3.1-specification.pdf
+//
+// Note, `sign` followed by `pk_from_sig` already computes each of 2^h leaves and
+// 2^h - 1 internal nodes exactly once, as authentication path nodes are roots of
+// disjoint subtrees. So # -of F, H and PRF calls is same, see
+// `sphincs_plus_cost_model::xmss_pkgen`, while `pk_from_sig`'s base-w pass over
+// message is all that's saved.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+sign_and_root(std::span<const uint8_t, n> msg,
+              std::span<const uint8_t, n> sk_seed,
+              const uint32_t idx,
+              std::span<const uint8_t, n> pk_seed,
+              const sphincs_plus_adrs::adrs_t adrs,
+              std::span<uint8_t, sphincs_plus_utils::compute_wots_len<n, w>() * n + h * n> sig,
+              std::span<uint8_t, n> root,
+              workspace_t<n>* const ws = nullptr)
 {
-  treehash<n, w, v>(sk_seed, 0u, h, pk_seed, adrs, pkey);
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t off0 = 0ul;
+  constexpr size_t off1 = off0 + len * n;
+
+  sphincs_plus_adrs::tree_t tree_adrs{ adrs };
+  tree_adrs.set_type(sphincs_plus_adrs::type_t::TREE);
+
+  auto leaf = [&](const uint32_t i, std::span<uint8_t, n> node) {
+    sphincs_plus_adrs::wots_hash_t hash_adrs{ adrs };
+
+    hash_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+    hash_adrs.set_keypair_address(i);
+
+    if (i == idx) {
+      sphincs_plus_wots::pkgen_and_sign<n, w, v>(msg, sk_seed, pk_seed, hash_adrs, node, sig.template subspan<off0, off1 - off0>());
+    } else {
+      sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, hash_adrs, node);
+    }
+  };
+
+  level_treehash<n, v>(pk_seed, 0u, h, tree_adrs, leaf, root, ws, sig.template subspan<off1, h * n>(), idx);
 }
 
 // Computes (len * n + h * n) -bytes XMSS signature, for n -bytes message, using
@@ -188,7 +547,7 @@ pk_from_sig(const uint32_t idx,
       auto _sig = std::span<const uint8_t, n>(sig.subspan(off, n));
       std::copy(_sig.begin(), _sig.end(), _c_nodes.template subspan<n, n>().begin());
 
-      sphincs_plus_hashing::h<n, v>(pk_seed, tree_adrs.data, _c_nodes, tmp);
+      sphincs_plus_hashing::h<n, v>(pk_seed, tree_adrs, _c_nodes, tmp);
 
       std::copy(tmp.begin(), tmp.end(), _c_nodes.template subspan<n, n>().begin());
     } else {
@@ -200,7 +559,7 @@ pk_from_sig(const uint32_t idx,
       auto _sig = std::span<const uint8_t, n>(sig.subspan(off, n));
       std::copy(_sig.begin(), _sig.end(), _c_nodes.template subspan<0, n>().begin());
 
-      sphincs_plus_hashing::h<n, v>(pk_seed, tree_adrs.data, _c_nodes, tmp);
+      sphincs_plus_hashing::h<n, v>(pk_seed, tree_adrs, _c_nodes, tmp);
 
       std::copy(tmp.begin(), tmp.end(), _c_nodes.template subspan<n, n>().begin());
     }
@@ -0,0 +1,196 @@
+#include "sphincs+_dispatch.hpp"
+#include "sphincs+.hpp"
+#include <array>
+
+namespace sphincs_plus_dispatch {
+
+// Entry of dispatch table, holding lengths and type-erased keygen/ sign/ verify routines of a parameter set
+struct entry_t
+{
+  const char* name;
+  size_t n;
+  size_t pklen;
+  size_t sklen;
+  size_t siglen;
+
+  void (*keygen)(std::span<const uint8_t>, std::span<const uint8_t>, std::span<const uint8_t>, std::span<uint8_t>, std::span<uint8_t>);
+  void (*sign)(std::span<const uint8_t>, std::span<const uint8_t>, std::span<const uint8_t>, std::span<uint8_t>);
+  bool (*verify)(std::span<const uint8_t>, std::span<const uint8_t>, std::span<const uint8_t>);
+};
+
+// Following routines are called only after lengths of all spans are checked, so that they can be turned into spans of
+// static extent, as expected by templated API.
+
+template<size_t n, uint32_t h, uint32_t d, size_t w, sphincs_plus_hashing::variant v>
+static void
+keygen_(std::span<const uint8_t> sk_seed, std::span<const uint8_t> sk_prf, std::span<const uint8_t> pk_seed, std::span<uint8_t> skey, std::span<uint8_t> pkey)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+
+  sphincs_plus::keygen<n, h, d, w, v>(std::span<const uint8_t, n>(sk_seed),
+                                      std::span<const uint8_t, n>(sk_prf),
+                                      std::span<const uint8_t, n>(pk_seed),
+                                      std::span<uint8_t, sklen>(skey),
+                                      std::span<uint8_t, pklen>(pkey));
+}
+
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static void
+sign_(std::span<const uint8_t> msg, std::span<const uint8_t> skey, std::span<const uint8_t> rand_bytes, std::span<uint8_t> sig)
+{
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  auto _skey = std::span<const uint8_t, sklen>(skey);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  if (rand_bytes.empty()) {
+    sphincs_plus::sign<n, h, d, a, k, w, v, false>(msg, _skey, {}, _sig);
+  } else {
+    sphincs_plus::sign<n, h, d, a, k, w, v, true>(msg, _skey, std::span<const uint8_t, n>(rand_bytes), _sig);
+  }
+}
+
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static bool
+verify_(std::span<const uint8_t> msg, std::span<const uint8_t> sig, std::span<const uint8_t> pkey)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  return sphincs_plus::verify<n, h, d, a, k, w, v>(msg, std::span<const uint8_t, siglen>(sig), std::span<const uint8_t, pklen>(pkey));
+}
+
+// Compile-time builds dispatch table entry of a parameter set, instantiating keygen/ sign/ verify for it.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static constexpr entry_t
+make_entry(const char* name)
+{
+  return { name,
+           n,
+           sphincs_plus_utils::get_sphincs_pkey_len<n>(),
+           sphincs_plus_utils::get_sphincs_skey_len<n>(),
+           sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>(),
+           keygen_<n, h, d, w, v>,
+           sign_<n, h, d, a, k, w, v>,
+           verify_<n, h, d, a, k, w, v> };
+}
+
+using sphincs_plus_hashing::variant;
+
+// Dispatch table, indexed by `param_set_t`
+constexpr std::array<entry_t, PARAM_SET_CNT> TABLE = { {
+  make_entry<16, 63, 7, 12, 14, 16, variant::robust>("sphincs+-128s-robust"),
+  make_entry<16, 63, 7, 12, 14, 16, variant::simple>("sphincs+-128s-simple"),
+  make_entry<16, 66, 22, 6, 33, 16, variant::robust>("sphincs+-128f-robust"),
+  make_entry<16, 66, 22, 6, 33, 16, variant::simple>("sphincs+-128f-simple"),
+  make_entry<24, 63, 7, 14, 17, 16, variant::robust>("sphincs+-192s-robust"),
+  make_entry<24, 63, 7, 14, 17, 16, variant::simple>("sphincs+-192s-simple"),
+  make_entry<24, 66, 22, 8, 33, 16, variant::robust>("sphincs+-192f-robust"),
+  make_entry<24, 66, 22, 8, 33, 16, variant::simple>("sphincs+-192f-simple"),
+  make_entry<32, 64, 8, 14, 22, 16, variant::robust>("sphincs+-256s-robust"),
+  make_entry<32, 64, 8, 14, 22, 16, variant::simple>("sphincs+-256s-simple"),
+  make_entry<32, 68, 17, 9, 35, 16, variant::robust>("sphincs+-256f-robust"),
+  make_entry<32, 68, 17, 9, 35, 16, variant::simple>("sphincs+-256f-simple"),
+} };
+
+// Returns dispatch table entry of parameter set, or nullptr, for an unknown one.
+static inline const entry_t*
+lookup(const param_set_t set)
+{
+  const auto idx = static_cast<size_t>(set);
+  return idx < TABLE.size() ? &TABLE[idx] : nullptr;
+}
+
+const char*
+name(const param_set_t set)
+{
+  const entry_t* e = lookup(set);
+  return e ? e->name : nullptr;
+}
+
+size_t
+n(const param_set_t set)
+{
+  const entry_t* e = lookup(set);
+  return e ? e->n : 0;
+}
+
+size_t
+pkey_len(const param_set_t set)
+{
+  const entry_t* e = lookup(set);
+  return e ? e->pklen : 0;
+}
+
+size_t
+skey_len(const param_set_t set)
+{
+  const entry_t* e = lookup(set);
+  return e ? e->sklen : 0;
+}
+
+size_t
+sig_len(const param_set_t set)
+{
+  const entry_t* e = lookup(set);
+  return e ? e->siglen : 0;
+}
+
+bool
+keygen(const param_set_t set,
+       std::span<const uint8_t> sk_seed,
+       std::span<const uint8_t> sk_prf,
+       std::span<const uint8_t> pk_seed,
+       std::span<uint8_t> skey,
+       std::span<uint8_t> pkey)
+{
+  const entry_t* e = lookup(set);
+  if (e == nullptr) {
+    return false;
+  }
+
+  const bool valid = (sk_seed.size() == e->n) && (sk_prf.size() == e->n) && (pk_seed.size() == e->n) && (skey.size() == e->sklen) && (pkey.size() == e->pklen);
+  if (!valid) {
+    return false;
+  }
+
+  e->keygen(sk_seed, sk_prf, pk_seed, skey, pkey);
+  return true;
+}
+
+bool
+sign(const param_set_t set, std::span<const uint8_t> msg, std::span<const uint8_t> skey, std::span<const uint8_t> rand_bytes, std::span<uint8_t> sig)
+{
+  const entry_t* e = lookup(set);
+  if (e == nullptr) {
+    return false;
+  }
+
+  const bool valid = (skey.size() == e->sklen) && (rand_bytes.empty() || rand_bytes.size() == e->n) && (sig.size() == e->siglen);
+  if (!valid) {
+    return false;
+  }
+
+  e->sign(msg, skey, rand_bytes, sig);
+  return true;
+}
+
+bool
+verify(const param_set_t set, std::span<const uint8_t> msg, std::span<const uint8_t> sig, std::span<const uint8_t> pkey)
+{
+  const entry_t* e = lookup(set);
+  if (e == nullptr) {
+    return false;
+  }
+
+  const bool valid = (sig.size() == e->siglen) && (pkey.size() == e->pklen);
+  if (!valid) {
+    return false;
+  }
+
+  return e->verify(msg, sig, pkey);
+}
+
+}
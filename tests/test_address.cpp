@@ -0,0 +1,54 @@
+#include "address.hpp"
+#include "prng.hpp"
+#include <gtest/gtest.h>
+
+// Test that SPHINCS+ ADRS, kept in native words, gets serialized to 32 -bytes, with each word in big-endian byte order,
+// as described in section 2.7.3 of SPHINCS+ specification, and that it can be parsed back. Also test that incremental
+// updates of hash address and tree index are same as setting them.
+TEST(SphincsPlus, AddressSerialization)
+{
+  sphincs_plus_adrs::wots_hash_t adrs{};
+
+  adrs.set_layer_address(0x01020304u);
+  adrs.set_tree_address(0x05060708090a0b0cul);
+  adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PRF);
+  adrs.set_keypair_address(0x0d0e0f10u);
+  adrs.set_chain_address(0x11121314u);
+  adrs.set_hash_address(0x15161718u);
+
+  constexpr std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> expected = {
+    0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c,
+    0x00, 0x00, 0x00, 0x05, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+  };
+
+  EXPECT_EQ(adrs.to_bytes(), expected);
+
+  const sphincs_plus_adrs::wots_hash_t parsed{ sphincs_plus_adrs::adrs_t(expected) };
+  EXPECT_EQ(parsed.words, adrs.words);
+
+  // Rewriting a single word of serialized ADRS must be same as serializing whole ADRS
+  auto bytes = adrs.to_bytes();
+  adrs.inc_hash_address();
+  adrs.template word_to_bytes<7>(bytes);
+
+  EXPECT_EQ(adrs.get_hash_address(), 0x15161719u);
+  EXPECT_EQ(bytes, adrs.to_bytes());
+
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> rand_bytes{};
+
+  prng::prng_t prng;
+  prng.read(rand_bytes);
+
+  sphincs_plus_adrs::fors_tree_t tree_adrs{ sphincs_plus_adrs::adrs_t(rand_bytes) };
+  EXPECT_EQ(tree_adrs.to_bytes(), rand_bytes);
+
+  const uint32_t idx = tree_adrs.get_tree_index();
+  for (uint32_t i = 1; i <= 16; i++) {
+    tree_adrs.inc_tree_index();
+
+    sphincs_plus_adrs::fors_tree_t tree_adrs_{ tree_adrs };
+    tree_adrs_.set_tree_index(idx + i);
+
+    EXPECT_EQ(tree_adrs.to_bytes(), tree_adrs_.to_bytes());
+  }
+}
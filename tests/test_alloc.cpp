@@ -0,0 +1,141 @@
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <vector>
+
+// # -of heap allocations made by calling thread, while counting is enabled
+static thread_local bool count_allocs = false;
+static std::atomic<size_t> alloc_cnt = 0;
+
+// Global replacement of allocation functions, counting allocations made by a thread, which has opted in, so that
+// allocations made by test framework itself, or by other threads, don't get counted.
+void*
+operator new(size_t size)
+{
+  if (count_allocs) {
+    alloc_cnt.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void*
+operator new[](size_t size)
+{
+  return ::operator new(size);
+}
+
+// Releases memory obtained from `operator new`. It's kept out of line, so that once replacement deallocation functions
+// get inlined into callers, compiler doesn't see `std::free` being called on a pointer returned by `new`.
+[[gnu::noinline]] static void
+release(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  release(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+// Test that SPHINCS+ key generation, signing and verification don't allocate on heap, with and without caller-supplied
+// workspace, while also checking that signing actually computes XMSS trees in the workspace, when supplied.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_no_alloc(const size_t mlen)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig0(siglen, 0);
+  std::vector<uint8_t> sig1(siglen, 0);
+  auto ws = std::make_unique<sphincs_plus_xmss::workspace_t<n>>();
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msg = std::span<uint8_t>(msg);
+  auto _sig0 = std::span<uint8_t, siglen>(sig0);
+  auto _sig1 = std::span<uint8_t, siglen>(sig1);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msg);
+
+  alloc_cnt = 0;
+  count_allocs = true;
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig0);
+  const bool flag0 = sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig0, _pkey);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey, ws.get());
+  std::fill(ws->nodes.begin(), ws->nodes.end(), 0x00);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig1, ws.get());
+  const bool flag1 = sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig1, _pkey);
+
+  count_allocs = false;
+
+  EXPECT_EQ(alloc_cnt.load(), 0ul);
+  EXPECT_TRUE(flag0);
+  EXPECT_TRUE(flag1);
+  EXPECT_EQ(sig0, sig1);
+
+  // XMSS tree on top layer of HyperTree is the last one computed while signing. When it fits in workspace, its root,
+  // left in workspace, must be the public key root, showing that workspace is used by HyperTree signing too.
+  constexpr uint32_t xh = h / d;
+  if constexpr (xh <= sphincs_plus_xmss::LEVEL_HEIGHT) {
+    constexpr size_t off = ((2ul << xh) - 2ul) * n;
+
+    auto root = std::span(ws->nodes).template subspan<off, n>();
+    auto pk_root = _pkey.template subspan<n, n>();
+    EXPECT_TRUE(std::equal(root.begin(), root.end(), pk_root.begin()));
+  }
+}
+
+TEST(SphincsPlus, KeygenSignVerifyWithoutHeapAllocation)
+{
+  test_no_alloc<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(32);
+  test_no_alloc<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::robust>(32);
+  test_no_alloc<32, 64, 8, 14, 22, 16, sphincs_plus_hashing::variant::robust>(32);
+  test_no_alloc<32, 64, 8, 14, 22, 16, sphincs_plus_hashing::variant::simple>(32);
+  test_no_alloc<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::robust>(32);
+  test_no_alloc<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>(32);
+}
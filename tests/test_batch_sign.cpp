@@ -0,0 +1,93 @@
+#include "batch_sign.hpp"
+#include "prng.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test correctness of SPHINCS+ batch signing, using
+//
+// - Keypair generation
+// - Signing a batch of messages, producing one signature and an inclusion proof per message
+// - Verifying each message, using (signature, inclusion proof) bundle, with and without authenticated root cache
+//
+// with random data.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_batch_sign(const size_t msg_cnt, const size_t mlen)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  const size_t proof_len = sphincs_plus_batch::get_proof_len<n>(msg_cnt);
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(msg_cnt * mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+  std::vector<uint8_t> proofs(msg_cnt * proof_len, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+  auto _proofs = std::span(proofs);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+
+  std::vector<std::span<const uint8_t>> batch;
+  for (size_t i = 0; i < msg_cnt; i++) {
+    batch.push_back(_msgs.subspan(i * mlen, mlen));
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus_batch::sign<n, h, d, a, k, w, v>(batch, _skey, {}, _sig, _proofs);
+
+  sphincs_plus_batch::verifier_t<n, h, d, a, k, w, v> verifier(_pkey);
+
+  for (size_t i = 0; i < msg_cnt; i++) {
+    auto proof = _proofs.subspan(i * proof_len, proof_len);
+
+    EXPECT_TRUE((sphincs_plus_batch::verify<n, h, d, a, k, w, v>(batch[i], _sig, proof, _pkey)));
+    EXPECT_TRUE(verifier.verify(batch[i], _sig, proof));
+  }
+
+  // Only the first message of the batch requires verifying SPHINCS+ signature
+  EXPECT_EQ(verifier.get_misses(), 1ul);
+  EXPECT_EQ(verifier.get_hits(), msg_cnt - 1);
+
+  // Inclusion proof of some other message of same batch must not work
+  if (msg_cnt > 1) {
+    auto other_proof = _proofs.subspan(proof_len, proof_len);
+    EXPECT_FALSE(verifier.verify(batch[0], _sig, other_proof));
+  }
+
+  // Tampered message must not be verified, neither with nor without authenticated root cache
+  std::vector<uint8_t> tampered(batch[0].begin(), batch[0].end());
+  tampered.push_back(0xff);
+
+  auto proof = _proofs.subspan(0, proof_len);
+  EXPECT_FALSE((sphincs_plus_batch::verify<n, h, d, a, k, w, v>(tampered, _sig, proof, _pkey)));
+  EXPECT_FALSE(verifier.verify(tampered, _sig, proof));
+
+  // Malformed proof must be rejected
+  EXPECT_FALSE(verifier.verify(batch[0], _sig, proof.subspan(0, proof_len - 1)));
+}
+
+TEST(SphincsPlus, BatchSignVerify)
+{
+  test_batch_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(1, 32);
+  test_batch_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(2, 32);
+  test_batch_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(3, 32);
+  test_batch_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::robust>(17, 64);
+  test_batch_sign<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>(64, 16);
+  test_batch_sign<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::robust>(129, 1);
+}
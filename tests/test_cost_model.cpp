@@ -0,0 +1,178 @@
+#define SPHINCS_PLUS_COUNTERS
+#include "cost_model.hpp"
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace cost_model = sphincs_plus_cost_model;
+
+// Computes checksum of base-w digits of n -bytes WOTS+ message, s.t. verifier needs to walk `csum` -many chain steps,
+// for message digits.
+template<size_t n, size_t w>
+static inline uint32_t
+compute_checksum(std::span<const uint8_t, n> msg)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t len1 = sphincs_plus_utils::compute_wots_len1<n, w>();
+
+  std::array<uint8_t, len> digits{};
+  sphincs_plus_wots::compute_digits<n, w>(msg, digits);
+
+  uint32_t csum = 0;
+  for (size_t i = 0; i < len1; i++) {
+    csum += static_cast<uint32_t>(w - 1) - static_cast<uint32_t>(digits[i]);
+  }
+
+  return csum;
+}
+
+// Test that cost of computing WOTS+ public key from signature, as modeled from checksum of message digits, matches
+// runtime counters exactly, and that it lies within compile-time computed bounds, whose average is close to sample
+// mean, over random messages.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_wots_cost_model()
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr cost_model::steps_t steps = cost_model::wots_verify_steps<n, w>();
+  static_assert(steps.min <= steps.max, "Bounds on # -of WOTS+ chain steps must be ordered !");
+
+  EXPECT_GE(steps.avg, static_cast<double>(steps.min));
+  EXPECT_LE(steps.avg, static_cast<double>(steps.max));
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n * len> sig{};
+  std::array<uint8_t, n> pkey{};
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(pk_seed);
+
+  sphincs_plus_adrs::wots_hash_t adrs{};
+  adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+  adrs.set_keypair_address(5u);
+
+  for (size_t t = 0; t < 16; t++) {
+    prng.read(msg);
+    sphincs_plus_wots::sign<n, w, v>(msg, sk_seed, pk_seed, adrs, sig);
+
+    const uint64_t expected = cost_model::wots_verify_steps<n, w>(compute_checksum<n, w>(msg));
+    EXPECT_GE(expected, steps.min);
+    EXPECT_LE(expected, steps.max);
+
+    sphincs_plus_counters::reset();
+    sphincs_plus_wots::pk_from_sig<n, w, v>(sig, msg, pk_seed, adrs, pkey);
+
+    EXPECT_EQ(sphincs_plus_counters::get(), (cost_model::wots_pk_from_sig<n, w, v>(expected)));
+  }
+
+  constexpr size_t samples = 1ul << 14;
+
+  double sum = 0.;
+  for (size_t t = 0; t < samples; t++) {
+    prng.read(msg);
+    sum += static_cast<double>(cost_model::wots_verify_steps<n, w>(compute_checksum<n, w>(msg)));
+  }
+
+  EXPECT_NEAR(sum / static_cast<double>(samples), steps.avg, steps.avg * 0.01);
+}
+
+TEST(SphincsPlus, CostModelWOTS)
+{
+  test_wots_cost_model<16, 4, sphincs_plus_hashing::variant::simple>();
+  test_wots_cost_model<16, 16, sphincs_plus_hashing::variant::simple>();
+  test_wots_cost_model<16, 256, sphincs_plus_hashing::variant::robust>();
+  test_wots_cost_model<24, 16, sphincs_plus_hashing::variant::robust>();
+  test_wots_cost_model<32, 16, sphincs_plus_hashing::variant::simple>();
+  test_wots_cost_model<32, 256, sphincs_plus_hashing::variant::simple>();
+}
+
+// Test that compile-time computed cost of SPHINCS+ key generation and signing matches runtime counters exactly, while
+// cost of verification, which depends on message digits, lies within compile-time computed bounds.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_sphincs_plus_cost_model(const size_t mlen)
+{
+  using sphincs_plus_counters::hash_t;
+  namespace utils = sphincs_plus_utils;
+
+  constexpr size_t pklen = utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> sk_prf{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, pklen> pkey{};
+  std::array<uint8_t, sklen> skey{};
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _msg = std::span<uint8_t>(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus_counters::reset();
+  sphincs_plus::keygen<n, h, d, w, v>(sk_seed, sk_prf, pk_seed, skey, pkey);
+  EXPECT_EQ(sphincs_plus_counters::get(), (cost_model::keygen<n, h, d, a, k, w, v>()));
+
+  sphincs_plus_counters::reset();
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, skey, {}, _sig);
+  EXPECT_EQ(sphincs_plus_counters::get(), (cost_model::sign<n, h, d, a, k, w, v>(mlen)));
+
+  sphincs_plus_counters::reset();
+  EXPECT_TRUE((sphincs_plus::verify<n, h, d, a, k, w, v>(_msg, _sig, pkey)));
+
+  const auto c = sphincs_plus_counters::get();
+  const auto bounds = cost_model::verify_cost<n, h, d, a, k, w, v>(mlen);
+
+  EXPECT_GE(c.get_calls(hash_t::f), bounds.min.get_calls(hash_t::f));
+  EXPECT_LE(c.get_calls(hash_t::f), bounds.max.get_calls(hash_t::f));
+  EXPECT_GE(static_cast<double>(c.permutations), static_cast<double>(bounds.min.permutations));
+  EXPECT_LE(static_cast<double>(c.permutations), static_cast<double>(bounds.max.permutations));
+
+  // Knowing # -of WOTS+ chain steps walked, everything else is exact
+  const uint64_t steps = c.get_calls(hash_t::f) - k;
+  EXPECT_EQ(c, (cost_model::verify<n, h, d, a, k, w, v>(mlen, steps)));
+}
+
+TEST(SphincsPlus, CostModelKeygenSignVerify)
+{
+  test_sphincs_plus_cost_model<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(32);
+  test_sphincs_plus_cost_model<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::robust>(1024);
+  test_sphincs_plus_cost_model<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>(0);
+  test_sphincs_plus_cost_model<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::robust>(300);
+}
+
+// Test that cost model is evaluable at compile-time.
+TEST(SphincsPlus, CostModelCompileTime)
+{
+  using sphincs_plus_counters::hash_t;
+
+  // SPHINCS+-SHAKE-128s-simple, where each of 7 layers has an XMSS tree of height 9 and WOTS+ len = 35
+  constexpr auto keygen = cost_model::keygen<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>();
+  static_assert(keygen.get_calls(hash_t::f) == 512ul * 35 * 15);
+  static_assert(keygen.get_calls(hash_t::h) == 511ul);
+  static_assert(keygen.get_calls(hash_t::prf) == 512ul * 35);
+
+  constexpr auto sign = cost_model::sign<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>(32);
+  static_assert(sign.get_calls(hash_t::prf) == 14ul * 4096 + 7 * keygen.get_calls(hash_t::prf));
+  static_assert(sign.get_calls(hash_t::h_msg) == 1ul);
+
+  constexpr auto verify = cost_model::verify_cost<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple>(32);
+  static_assert(verify.min.get_calls(hash_t::f) <= verify.max.get_calls(hash_t::f));
+  static_assert(verify.avg_calls >= static_cast<double>(verify.min.get_total_calls()));
+  static_assert(verify.avg_calls <= static_cast<double>(verify.max.get_total_calls()));
+
+  static_assert(cost_model::workspace_bytes<16>() == 127ul * 16);
+  static_assert(cost_model::multi_sign_tree_bytes<63, 7, 16>() == 1023ul * 16);
+  static_assert(cost_model::node_cache_bytes<63, 7, 16>(1ul << 12) > 0);
+}
@@ -0,0 +1,86 @@
+#define SPHINCS_PLUS_COUNTERS
+#include "prng.hpp"
+#include "xmss.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+// Test that hash counters record exact # -of F, H, T_l and PRF invocations, along with Keccak-f[1600] permutations
+// they require, for WOTS+ key generation and XMSS tree root computation, and that counters are kept per thread.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_hash_counters()
+{
+  using sphincs_plus_counters::hash_t;
+  using sphincs_plus_counters::shake256_permutations;
+
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t alen = sphincs_plus_adrs::ADRS_BYTE_WIDTH;
+  constexpr bool robust = v == sphincs_plus_hashing::variant::robust;
+
+  constexpr uint64_t f_perms = 1 + robust;
+  constexpr uint64_t h_perms = 1 + robust;
+  constexpr uint64_t prf_perms = 1;
+  constexpr uint64_t t_len_perms = shake256_permutations(n + alen + n * len, n) + (robust ? shake256_permutations(n + alen, n * len) : 0);
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> pkey{};
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(pk_seed);
+
+  sphincs_plus_adrs::adrs_t adrs{};
+  adrs.set_layer_address(1u);
+  adrs.set_tree_address(7ul);
+
+  sphincs_plus_counters::reset();
+  EXPECT_EQ(sphincs_plus_counters::get().get_total_calls(), 0ul);
+
+  // WOTS+ key generation
+  sphincs_plus_adrs::wots_hash_t wots_adrs{ adrs };
+  wots_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_HASH);
+  wots_adrs.set_keypair_address(3u);
+
+  sphincs_plus_wots::pkgen<n, w, v>(sk_seed, pk_seed, wots_adrs, pkey);
+
+  const auto c0 = sphincs_plus_counters::get();
+
+  EXPECT_EQ(c0.get_calls(hash_t::f), len * (w - 1));
+  EXPECT_EQ(c0.get_calls(hash_t::h), 0ul);
+  EXPECT_EQ(c0.get_calls(hash_t::t_l), 1ul);
+  EXPECT_EQ(c0.get_calls(hash_t::prf), len);
+  EXPECT_EQ(c0.permutations, len * (w - 1) * f_perms + len * prf_perms + t_len_perms);
+
+  // XMSS tree root, which requires 2^h WOTS+ key generations and 2^h - 1 H calls
+  sphincs_plus_counters::reset();
+  sphincs_plus_xmss::pkgen<h, n, w, v>(sk_seed, pk_seed, adrs, pkey);
+
+  const auto c1 = sphincs_plus_counters::get();
+  constexpr uint64_t leaves = 1ul << h;
+
+  EXPECT_EQ(c1.get_calls(hash_t::f), leaves * len * (w - 1));
+  EXPECT_EQ(c1.get_calls(hash_t::h), leaves - 1);
+  EXPECT_EQ(c1.get_calls(hash_t::t_l), leaves);
+  EXPECT_EQ(c1.get_calls(hash_t::prf), leaves * len);
+  EXPECT_EQ(c1.permutations, leaves * c0.permutations + (leaves - 1) * h_perms);
+
+  // Hashing on some other thread must not show up in counters of this thread
+  std::thread worker([&]() {
+    std::array<uint8_t, n> root{};
+    sphincs_plus_xmss::pkgen<h, n, w, v>(sk_seed, pk_seed, adrs, root);
+
+    EXPECT_EQ(sphincs_plus_counters::get().permutations, c1.permutations);
+  });
+  worker.join();
+
+  EXPECT_EQ(sphincs_plus_counters::get().permutations, c1.permutations);
+}
+
+TEST(SphincsPlus, HashCounters)
+{
+  test_hash_counters<3, 16, 16, sphincs_plus_hashing::variant::simple>();
+  test_hash_counters<3, 16, 16, sphincs_plus_hashing::variant::robust>();
+  test_hash_counters<4, 24, 16, sphincs_plus_hashing::variant::simple>();
+  test_hash_counters<3, 32, 16, sphincs_plus_hashing::variant::robust>();
+}
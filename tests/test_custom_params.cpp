@@ -0,0 +1,97 @@
+#include "prng.hpp"
+#include "sphincs+_custom.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using sphincs_plus_hashing::variant;
+
+// Whether a custom parameter set can be instantiated, as per compile-time checks of parameters
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, variant v>
+concept instantiable = requires { typename sphincs_plus_custom::params_t<n, h, d, a, k, w, v>; };
+
+// Parameter sets of table 3 of the specification
+static_assert(instantiable<16, 63, 7, 12, 14, 16, variant::robust>);
+static_assert(instantiable<16, 66, 22, 6, 33, 16, variant::simple>);
+static_assert(instantiable<24, 63, 7, 14, 17, 16, variant::robust>);
+static_assert(instantiable<24, 66, 22, 8, 33, 16, variant::simple>);
+static_assert(instantiable<32, 64, 8, 14, 22, 16, variant::robust>);
+static_assert(instantiable<32, 68, 17, 9, 35, 16, variant::simple>);
+
+// Custom ones, satisfying constraints
+static_assert(instantiable<16, 12, 2, 12, 10, 256, variant::simple>);
+static_assert(instantiable<16, 8, 1, 8, 12, 4, variant::robust>);
+static_assert(instantiable<32, 72, 9, 16, 65536, 256, variant::simple>);
+
+// Violating constraints
+static_assert(!instantiable<20, 63, 7, 12, 14, 16, variant::simple>);  // n isn't one of 16, 24, 32
+static_assert(!instantiable<16, 63, 7, 12, 14, 8, variant::simple>);   // w isn't one of 4, 16, 256
+static_assert(!instantiable<16, 64, 7, 12, 14, 16, variant::simple>);  // d doesn't divide h
+static_assert(!instantiable<16, 66, 0, 12, 14, 16, variant::simple>);  // no layers
+static_assert(!instantiable<16, 64, 2, 12, 14, 16, variant::simple>);  // XMSS tree height h / d >= 32
+static_assert(!instantiable<32, 70, 35, 12, 14, 16, variant::simple>); // h - h / d > 64
+static_assert(!instantiable<16, 63, 7, 0, 14, 16, variant::simple>);   // FORS tree of height 0
+static_assert(!instantiable<16, 63, 7, 12, 0, 16, variant::simple>);   // no FORS trees
+static_assert(!instantiable<16, 63, 7, 16, 65537, 16, variant::simple>); // k * 2^a doesn't fit in 32 -bit FORS tree index
+
+// WOTS+ len = len1 + len2 s.t. len2 = floor(log_w(len1 * (w - 1))) + 1, see section 3.1 of the specification
+static_assert(sphincs_plus_utils::compute_wots_len<16, 4>() == 64 + 4);
+static_assert(sphincs_plus_utils::compute_wots_len<24, 4>() == 96 + 5);
+static_assert(sphincs_plus_utils::compute_wots_len<16, 16>() == 35);
+static_assert(sphincs_plus_utils::compute_wots_len<24, 16>() == 51);
+static_assert(sphincs_plus_utils::compute_wots_len<32, 16>() == 67);
+static_assert(sphincs_plus_utils::compute_wots_len<16, 256>() == 16 + 2);
+static_assert(sphincs_plus_utils::compute_wots_len<32, 256>() == 32 + 2);
+
+// Test correctness of SPHINCS+ keygen, sign and verify, instantiated with a custom parameter set, for both
+// deterministic and randomized signing, while also checking that tampered signature doesn't verify.
+template<typename params>
+static inline void
+test_custom_params(const size_t mlen)
+{
+  constexpr size_t n = params::n;
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(params::PubKeyLen, 0);
+  std::vector<uint8_t> skey(params::SecKeyLen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> rand_bytes(n, 0);
+  std::vector<uint8_t> sig(params::SigLen, 0);
+
+  auto _sk_seed = std::span<const uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<const uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<const uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, params::PubKeyLen>(pkey);
+  auto _skey = std::span<uint8_t, params::SecKeyLen>(skey);
+  auto _rand_bytes = std::span<const uint8_t, n>(rand_bytes);
+  auto _sig = std::span<uint8_t, params::SigLen>(sig);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(msg);
+  prng.read(rand_bytes);
+
+  params::keygen(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+
+  params::sign(msg, _skey, {}, _sig);
+  EXPECT_TRUE(params::verify(msg, _sig, _pkey));
+
+  params::template sign<true>(msg, _skey, _rand_bytes, _sig);
+  EXPECT_TRUE(params::verify(msg, _sig, _pkey));
+
+  sig[params::SigLen - 1] ^= 0x80u;
+  EXPECT_FALSE(params::verify(msg, _sig, _pkey));
+}
+
+TEST(SphincsPlus, CustomParameterSets)
+{
+  using sphincs_plus_custom::params_t;
+
+  test_custom_params<params_t<16, 12, 2, 12, 10, 256, variant::simple>>(32);
+  test_custom_params<params_t<16, 8, 1, 8, 12, 4, variant::robust>>(32);
+  test_custom_params<params_t<24, 20, 4, 10, 16, 16, variant::simple>>(32);
+  test_custom_params<params_t<32, 16, 4, 6, 20, 256, variant::robust>>(32);
+}
@@ -0,0 +1,107 @@
+#include "prng.hpp"
+#include "sphincs+.hpp"
+#include "sphincs+_dispatch.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test that keygen, sign and verify, dispatched on parameter set at runtime, produce same keys and signatures as
+// templated API does, for given parameter set, and that malformed inputs are rejected.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_dispatch(const sphincs_plus_dispatch::param_set_t set, const size_t mlen)
+{
+  namespace dispatch = sphincs_plus_dispatch;
+  namespace utils = sphincs_plus_utils;
+  constexpr size_t pklen = utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  EXPECT_EQ(dispatch::n(set), n);
+  EXPECT_EQ(dispatch::pkey_len(set), pklen);
+  EXPECT_EQ(dispatch::skey_len(set), sklen);
+  EXPECT_EQ(dispatch::sig_len(set), siglen);
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey0(pklen, 0);
+  std::vector<uint8_t> pkey1(pklen, 0);
+  std::vector<uint8_t> skey0(sklen, 0);
+  std::vector<uint8_t> skey1(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> rand_bytes(n, 0);
+  std::vector<uint8_t> sig0(siglen, 0);
+  std::vector<uint8_t> sig1(siglen, 0);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(sk_prf);
+  prng.read(pk_seed);
+  prng.read(msg);
+  prng.read(rand_bytes);
+
+  auto _sk_seed = std::span<const uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<const uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<const uint8_t, n>(pk_seed);
+  auto _skey0 = std::span<uint8_t, sklen>(skey0);
+  auto _pkey0 = std::span<uint8_t, pklen>(pkey0);
+  auto _sig0 = std::span<uint8_t, siglen>(sig0);
+
+  // Templated API
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey0, _pkey0);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(msg, _skey0, {}, _sig0);
+
+  // Dispatched API
+  EXPECT_TRUE(dispatch::keygen(set, sk_seed, sk_prf, pk_seed, skey1, pkey1));
+  EXPECT_TRUE(dispatch::sign(set, msg, skey1, {}, sig1));
+
+  EXPECT_EQ(skey0, skey1);
+  EXPECT_EQ(pkey0, pkey1);
+  EXPECT_EQ(sig0, sig1);
+  EXPECT_TRUE(dispatch::verify(set, msg, sig1, pkey1));
+
+  // Randomized signing
+  EXPECT_TRUE(dispatch::sign(set, msg, skey1, rand_bytes, sig1));
+  EXPECT_TRUE(dispatch::verify(set, msg, sig1, pkey1));
+  EXPECT_NE(sig0, sig1);
+
+  // Tampered signature
+  sig1[siglen / 2] ^= 1u;
+  EXPECT_FALSE(dispatch::verify(set, msg, sig1, pkey1));
+
+  // Malformed lengths are rejected, without touching outputs
+  auto short_sig = std::span(sig1).first(siglen - 1);
+  auto short_pkey = std::span(pkey1).first(pklen - 1);
+  auto short_rand = std::span(rand_bytes).first(n - 1);
+
+  EXPECT_FALSE(dispatch::keygen(set, short_rand, sk_prf, pk_seed, skey1, pkey1));
+  EXPECT_FALSE(dispatch::sign(set, msg, skey1, short_rand, sig1));
+  EXPECT_FALSE(dispatch::sign(set, msg, skey1, {}, short_sig));
+  EXPECT_FALSE(dispatch::verify(set, msg, sig0, short_pkey));
+  EXPECT_EQ(skey0, skey1);
+}
+
+TEST(SphincsPlus, RuntimeParameterSetDispatch)
+{
+  using sphincs_plus_dispatch::param_set_t;
+  using sphincs_plus_hashing::variant;
+
+  test_dispatch<16, 63, 7, 12, 14, 16, variant::robust>(param_set_t::sphincs_plus_128s_robust, 32);
+  test_dispatch<16, 63, 7, 12, 14, 16, variant::simple>(param_set_t::sphincs_plus_128s_simple, 32);
+  test_dispatch<16, 66, 22, 6, 33, 16, variant::robust>(param_set_t::sphincs_plus_128f_robust, 32);
+  test_dispatch<16, 66, 22, 6, 33, 16, variant::simple>(param_set_t::sphincs_plus_128f_simple, 32);
+  test_dispatch<24, 63, 7, 14, 17, 16, variant::robust>(param_set_t::sphincs_plus_192s_robust, 32);
+  test_dispatch<24, 63, 7, 14, 17, 16, variant::simple>(param_set_t::sphincs_plus_192s_simple, 32);
+  test_dispatch<24, 66, 22, 8, 33, 16, variant::robust>(param_set_t::sphincs_plus_192f_robust, 32);
+  test_dispatch<24, 66, 22, 8, 33, 16, variant::simple>(param_set_t::sphincs_plus_192f_simple, 32);
+  test_dispatch<32, 64, 8, 14, 22, 16, variant::robust>(param_set_t::sphincs_plus_256s_robust, 32);
+  test_dispatch<32, 64, 8, 14, 22, 16, variant::simple>(param_set_t::sphincs_plus_256s_simple, 32);
+  test_dispatch<32, 68, 17, 9, 35, 16, variant::robust>(param_set_t::sphincs_plus_256f_robust, 32);
+  test_dispatch<32, 68, 17, 9, 35, 16, variant::simple>(param_set_t::sphincs_plus_256f_simple, 32);
+
+  // Unknown parameter set
+  const auto unknown = static_cast<param_set_t>(sphincs_plus_dispatch::PARAM_SET_CNT);
+  EXPECT_EQ(sphincs_plus_dispatch::name(unknown), nullptr);
+  EXPECT_EQ(sphincs_plus_dispatch::sig_len(unknown), 0ul);
+  EXPECT_FALSE(sphincs_plus_dispatch::verify(unknown, {}, {}, {}));
+}
@@ -71,3 +71,77 @@ TEST(SphincsPlus, FORSNISTSecurityLevel5)
   test_fors<32, 9, 35, sphincs_plus_hashing::variant::robust>();
   test_fors<32, 9, 35, sphincs_plus_hashing::variant::simple>();
 }
+
+// Recursively computes n -bytes root node of FORS subtree of height `n_height`, with leftmost leaf node at index
+// `s_idx`, following definition of FORS tree nodes, described in section 5.3 of SPHINCS+ specification.
+template<size_t n, sphincs_plus_hashing::variant v>
+static inline void
+fors_subtree_root(std::span<const uint8_t, n> sk_seed,
+                  const uint32_t s_idx,
+                  const uint32_t n_height,
+                  std::span<const uint8_t, n> pk_seed,
+                  sphincs_plus_adrs::fors_tree_t adrs,
+                  std::span<uint8_t, n> root)
+{
+  if (n_height == 0) {
+    std::array<uint8_t, n> sk_val{};
+    sphincs_plus_fors::skgen<n>(pk_seed, sk_seed, adrs, s_idx, sk_val);
+
+    adrs.set_tree_height(0u);
+    adrs.set_tree_index(s_idx);
+
+    sphincs_plus_hashing::f<n, v>(pk_seed, adrs, sk_val, root);
+    return;
+  }
+
+  std::array<uint8_t, n + n> c_nodes{};
+  auto _c_nodes = std::span(c_nodes);
+
+  fors_subtree_root<n, v>(sk_seed, s_idx, n_height - 1, pk_seed, adrs, _c_nodes.template subspan<0, n>());
+  fors_subtree_root<n, v>(sk_seed, s_idx + (1u << (n_height - 1)), n_height - 1, pk_seed, adrs, _c_nodes.template subspan<n, n>());
+
+  adrs.set_tree_height(n_height);
+  adrs.set_tree_index(s_idx >> n_height);
+
+  sphincs_plus_hashing::h<n, v>(pk_seed, adrs, c_nodes, root);
+}
+
+// Test that level-synchronous FORS treehash produces same root as recursive definition of FORS subtree, for subtrees
+// of height smaller than, equal to and larger than the height of subtrees, computed level by level.
+template<size_t n, uint32_t a, sphincs_plus_hashing::variant v>
+static inline void
+test_fors_treehash()
+{
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  sphincs_plus_adrs::fors_tree_t adrs{};
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(pk_seed);
+
+  adrs.set_layer_address(0u);
+  adrs.set_tree_address(0x0102030405ul);
+  adrs.set_type(sphincs_plus_adrs::type_t::FORS_TREE);
+  adrs.set_keypair_address(7u);
+
+  for (uint32_t j = 0; j <= a; j++) {
+    // Rightmost subtree of height j, in 2nd FORS tree
+    const uint32_t s_idx = (1u << a) + (((1u << a) - 1u) >> j << j);
+
+    std::array<uint8_t, n> root0{};
+    std::array<uint8_t, n> root1{};
+
+    sphincs_plus_fors::treehash<n, v>(sk_seed, s_idx, j, pk_seed, adrs, root0);
+    fors_subtree_root<n, v>(sk_seed, s_idx, j, pk_seed, adrs, root1);
+
+    EXPECT_EQ(root0, root1);
+  }
+}
+
+TEST(SphincsPlus, FORSLevelSynchronousTreehash)
+{
+  test_fors_treehash<16, 9, sphincs_plus_hashing::variant::robust>();
+  test_fors_treehash<24, 8, sphincs_plus_hashing::variant::simple>();
+  test_fors_treehash<32, 9, sphincs_plus_hashing::variant::simple>();
+}
@@ -70,3 +70,117 @@ TEST(SphincsPlus, HyperTreeNISTSecurityLevel5)
   test_hypertree<68, 17, 32, 16, sphincs_plus_hashing::variant::robust>();
   test_hypertree<68, 17, 32, 16, sphincs_plus_hashing::variant::simple>();
 }
+
+// Test correctness of HyperTree signature verification, when verified-node cache is used, by
+//
+// - Signing many random messages, under same public key, at random XMSS tree and leaf indices
+// - Verifying each signature, with and without verified-node cache
+// - Ensuring that tampered signatures are rejected and a cache, bound to some other public key, is ignored
+//
+// with random data.
+template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_hypertree_node_cache(const size_t sig_cnt)
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t sig_len = (h + d * len) * n;
+  constexpr size_t xmss_sig_len = (h / d + len) * n;
+  constexpr uint32_t h_ = h - (h / d);
+  constexpr uint64_t tree_mask = (h_ == 64u) ? ~0ul : ((1ul << h_) - 1ul);
+  constexpr uint32_t leaf_mask = (1u << (h / d)) - 1u;
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> msg(n, 0);
+  std::vector<uint8_t> pkey(n, 0);
+  std::vector<uint8_t> sig(sig_len, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _msg = std::span<uint8_t, n>(msg);
+  auto _pkey = std::span<uint8_t, n>(pkey);
+  auto _sig = std::span<uint8_t, sig_len>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_pk_seed);
+
+  sphincs_plus_ht::pkgen<h, d, n, w, v>(_sk_seed, _pk_seed, _pkey);
+
+  sphincs_plus_node_cache::node_cache_t<h, d, n, w, v> cache(_pk_seed, _pkey);
+
+  uint64_t itree = 0;
+  uint32_t ileaf = 0;
+
+  for (size_t i = 0; i < sig_cnt; i++) {
+    std::array<uint8_t, 12> idx{};
+    auto _idx = std::span(idx);
+
+    prng.read(_idx);
+    prng.read(_msg);
+
+    const uint64_t hi = sphincs_plus_utils::from_be_bytes(_idx.template subspan<0, 4>());
+    const uint64_t lo = sphincs_plus_utils::from_be_bytes(_idx.template subspan<4, 4>());
+
+    itree = ((hi << 32) | lo) & tree_mask;
+    ileaf = sphincs_plus_utils::from_be_bytes(_idx.template subspan<8, 4>()) & leaf_mask;
+
+    sphincs_plus_ht::sign<h, d, n, w, v>(_msg, _sk_seed, _pk_seed, itree, ileaf, _sig);
+
+    EXPECT_TRUE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey)));
+    EXPECT_TRUE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey, &cache)));
+
+    // Tampering with bottom layer XMSS signature must be detected, even when cache is used
+    _sig[0] ^= 0x01;
+    EXPECT_FALSE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey, &cache)));
+    _sig[0] ^= 0x01;
+
+    // Once bottom layer XMSS tree root is authenticated, upper layers of signature aren't verified again
+    _sig[xmss_sig_len] ^= 0x01;
+    EXPECT_FALSE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey)));
+    EXPECT_TRUE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey, &cache)));
+    _sig[xmss_sig_len] ^= 0x01;
+  }
+
+  // Each iteration has 2 successful verifications and 1 failed one, using cache. Failed one never stops early, while
+  // the last one always stops at bottom layer
+  EXPECT_EQ(cache.get_hits() + cache.get_misses(), 3 * sig_cnt);
+  EXPECT_EQ(cache.get_layer_hits(0), sig_cnt);
+  EXPECT_GE(cache.get_misses(), sig_cnt + 1);
+
+  // Cache bound to some other public key must be ignored
+  std::vector<uint8_t> other_pkey(pkey);
+  other_pkey[0] ^= 0x01;
+
+  sphincs_plus_node_cache::node_cache_t<h, d, n, w, v> other_cache(_pk_seed, std::span<const uint8_t, n>(other_pkey));
+
+  EXPECT_TRUE((sphincs_plus_ht::verify<h, d, n, w, v>(_msg, _sig, _pk_seed, itree, ileaf, _pkey, &other_cache)));
+  EXPECT_EQ(other_cache.get_hits() + other_cache.get_misses(), 0ul);
+}
+
+// Whether a verified-node cache of type `cache_type` can be passed to HyperTree signature verification, instantiated
+// with given parameters
+template<uint32_t h, uint32_t d, size_t n, size_t w, sphincs_plus_hashing::variant v, typename cache_type>
+concept accepts_node_cache = requires(std::span<const uint8_t, n> msg,
+                                      std::span<const uint8_t, (h + d * sphincs_plus_utils::compute_wots_len<n, w>()) * n> sig,
+                                      std::span<const uint8_t, n> pk_seed,
+                                      std::span<const uint8_t, n> pkey,
+                                      cache_type* cache) { sphincs_plus_ht::verify<h, d, n, w, v>(msg, sig, pk_seed, 0ul, 0u, pkey, cache); };
+
+// Cache is bound to w and tweakable hash function variant, so a cache filled under other hashing rules, along with
+// same public key bytes, is rejected
+using sphincs_plus_hashing::variant;
+using sphincs_plus_node_cache::node_cache_t;
+
+static_assert(accepts_node_cache<66, 22, 16, 16, variant::simple, node_cache_t<66, 22, 16, 16, variant::simple>>);
+static_assert(!accepts_node_cache<66, 22, 16, 16, variant::simple, node_cache_t<66, 22, 16, 16, variant::robust>>);
+static_assert(!accepts_node_cache<66, 22, 16, 16, variant::simple, node_cache_t<66, 22, 16, 256, variant::simple>>);
+static_assert(!accepts_node_cache<66, 22, 16, 4, variant::robust, node_cache_t<66, 22, 16, 16, variant::robust>>);
+
+TEST(SphincsPlus, HyperTreeVerifiedNodeCache)
+{
+  test_hypertree_node_cache<63, 7, 16, 16, sphincs_plus_hashing::variant::simple>(2);
+  test_hypertree_node_cache<66, 22, 16, 16, sphincs_plus_hashing::variant::robust>(8);
+  test_hypertree_node_cache<66, 22, 24, 16, sphincs_plus_hashing::variant::simple>(8);
+  test_hypertree_node_cache<68, 17, 32, 16, sphincs_plus_hashing::variant::simple>(4);
+}
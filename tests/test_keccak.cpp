@@ -0,0 +1,122 @@
+#include "keccak.hpp"
+#include "prng.hpp"
+#include "shake256.hpp"
+#include <gtest/gtest.h>
+
+// Straightforward Keccak-f[1600] permutation, following section 3.2 of SHA3 specification
+// https://dx.doi.org/10.6028/NIST.FIPS.202, against which optimized permutation is tested.
+static inline void
+reference_permute(sphincs_plus_keccak::state_t& A)
+{
+  constexpr std::array<int, 25> rot = { 0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14 };
+
+  for (size_t r = 0; r < sphincs_plus_keccak::ROUNDS; r++) {
+    std::array<uint64_t, 5> C{};
+    for (size_t x = 0; x < 5; x++) {
+      C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
+    }
+    for (size_t i = 0; i < 25; i++) {
+      A[i] ^= C[(i + 4) % 5] ^ std::rotl(C[(i + 1) % 5], 1);
+    }
+
+    sphincs_plus_keccak::state_t B{};
+    for (size_t x = 0; x < 5; x++) {
+      for (size_t y = 0; y < 5; y++) {
+        B[y + 5 * ((2 * x + 3 * y) % 5)] = std::rotl(A[x + 5 * y], rot[x + 5 * y]);
+      }
+    }
+
+    for (size_t x = 0; x < 5; x++) {
+      for (size_t y = 0; y < 5; y++) {
+        A[x + 5 * y] = B[x + 5 * y] ^ (~B[(x + 1) % 5 + 5 * y] & B[(x + 2) % 5 + 5 * y]);
+      }
+    }
+
+    A[0] ^= sphincs_plus_keccak::RC[r];
+  }
+}
+
+// Test that `ways` -many states, permuted together, with or without lane complementing, are same as permuting each of
+// them using reference permutation.
+template<size_t ways, bool lane_complementing>
+static inline void
+test_keccak_permutation()
+{
+  prng::prng_t prng;
+
+  for (size_t t = 0; t < 16; t++) {
+    std::array<sphincs_plus_keccak::state_t, ways> st{};
+    for (auto& s : st) {
+      std::array<uint8_t, sizeof(s)> bytes{};
+      prng.read(bytes);
+      std::memcpy(s.data(), bytes.data(), bytes.size());
+    }
+
+    auto expected = st;
+    for (auto& s : expected) {
+      reference_permute(s);
+    }
+
+    sphincs_plus_keccak::permute<ways, lane_complementing>(st);
+    EXPECT_EQ(st, expected);
+  }
+}
+
+TEST(SphincsPlus, KeccakPermutation)
+{
+  test_keccak_permutation<1, false>();
+  test_keccak_permutation<1, true>();
+  test_keccak_permutation<2, false>();
+  test_keccak_permutation<2, true>();
+  test_keccak_permutation<3, false>();
+  test_keccak_permutation<3, true>();
+}
+
+// Test that single-block SHAKE256, computed on one or two messages at a time, is same as incremental SHAKE256.
+template<size_t ilen, size_t olen>
+static inline void
+test_single_block_shake256()
+{
+  prng::prng_t prng;
+
+  std::array<uint8_t, 2 * ilen> msgs{};
+  prng.read(msgs);
+
+  auto _msgs = std::span(msgs);
+  auto msg0 = _msgs.template subspan<0, ilen>();
+  auto msg1 = _msgs.template subspan<ilen, ilen>();
+
+  std::array<uint8_t, 2 * olen> expected{};
+  auto _expected = std::span(expected);
+
+  shake256::shake256_t hasher0;
+  hasher0.absorb(msg0);
+  hasher0.finalize();
+  hasher0.squeeze(_expected.template subspan<0, olen>());
+
+  shake256::shake256_t hasher1;
+  hasher1.absorb(msg1);
+  hasher1.finalize();
+  hasher1.squeeze(_expected.template subspan<olen, olen>());
+
+  std::array<uint8_t, olen> dig{};
+  sphincs_plus_keccak::shake256<ilen, olen>(msg0, dig);
+  EXPECT_TRUE(std::equal(dig.begin(), dig.end(), expected.begin()));
+
+  std::array<uint8_t, 2 * olen> digs{};
+  sphincs_plus_keccak::shake256<ilen, olen, 2>(msgs, digs);
+  EXPECT_EQ(digs, expected);
+}
+
+TEST(SphincsPlus, KeccakSingleBlockSHAKE256)
+{
+  test_single_block_shake256<0, 32>();
+  test_single_block_shake256<1, 16>();
+  test_single_block_shake256<48, 16>();
+  test_single_block_shake256<64, 32>();
+  test_single_block_shake256<72, 24>();
+  test_single_block_shake256<80, 48>();
+  test_single_block_shake256<96, 32>();
+  test_single_block_shake256<128, 64>();
+  test_single_block_shake256<135, 136>();
+}
@@ -0,0 +1,130 @@
+#include "multi_sign.hpp"
+#include "prng.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test that XMSS signatures assembled from whole XMSS tree are same as the ones computed using algorithm 9 of SPHINCS+
+// specification, while root of the tree is same as XMSS public key.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_xmss_build_tree()
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t sig_len = (h + len) * n;
+  constexpr size_t tree_len = sphincs_plus_xmss::get_tree_len<h, n>();
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n> pkey{};
+  std::array<uint8_t, sig_len> sig0{};
+  std::array<uint8_t, sig_len> sig1{};
+  std::vector<uint8_t> nodes(tree_len, 0);
+
+  auto _nodes = std::span<uint8_t, tree_len>(nodes);
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(pk_seed);
+  prng.read(msg);
+
+  sphincs_plus_adrs::adrs_t adrs{};
+  adrs.set_layer_address(1u);
+  adrs.set_tree_address(7ul);
+
+  sphincs_plus_xmss::pkgen<h, n, w, v>(sk_seed, pk_seed, adrs, pkey);
+  sphincs_plus_xmss::build_tree<h, n, w, v>(sk_seed, pk_seed, adrs, _nodes);
+
+  EXPECT_TRUE(std::equal(pkey.begin(), pkey.end(), _nodes.template last<n>().begin()));
+
+  for (uint32_t idx = 0; idx < (1u << h); idx++) {
+    sphincs_plus_xmss::sign<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, sig0);
+    sphincs_plus_xmss::sign_from_tree<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, _nodes, sig1);
+
+    EXPECT_EQ(sig0, sig1);
+  }
+}
+
+TEST(SphincsPlus, XMSSBuildTree)
+{
+  test_xmss_build_tree<3, 16, 16, sphincs_plus_hashing::variant::robust>();
+  test_xmss_build_tree<3, 24, 16, sphincs_plus_hashing::variant::simple>();
+  test_xmss_build_tree<4, 32, 16, sphincs_plus_hashing::variant::simple>();
+}
+
+// Test that locality-aware signing of many messages produces signatures, which are byte-identical to the ones produced
+// by signing each message separately, using
+//
+// - Keypair generation
+// - Signing a batch of messages, possibly with duplicates, at once
+// - Signing each message separately and comparing signatures
+// - Verifying each signature
+//
+// with random data.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v, bool randomize>
+static inline void
+test_multi_sign(const size_t msg_cnt, const size_t mlen)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msgs(msg_cnt * mlen, 0);
+  std::vector<uint8_t> rand_bytes(msg_cnt * n * randomize, 0);
+  std::vector<uint8_t> sigs(msg_cnt * siglen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msgs = std::span(msgs);
+  auto _rand_bytes = std::span(rand_bytes);
+  auto _sigs = std::span(sigs);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msgs);
+  prng.read(_rand_bytes);
+
+  // Last message of batch duplicates the first one
+  std::vector<std::span<const uint8_t>> batch;
+  for (size_t i = 0; i < msg_cnt; i++) {
+    batch.push_back(_msgs.subspan(((i + 1 == msg_cnt) && (msg_cnt > 1)) ? 0 : i * mlen, mlen));
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus_multi::sign<n, h, d, a, k, w, v, randomize>(batch, _skey, _rand_bytes, _sigs);
+
+  for (size_t i = 0; i < msg_cnt; i++) {
+    auto sig_ = _sigs.subspan(i * siglen, siglen);
+
+    if constexpr (randomize) {
+      auto rb = std::span<const uint8_t, n>(_rand_bytes.subspan(i * n, n));
+      sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(batch[i], _skey, rb, _sig);
+    } else {
+      sphincs_plus::sign<n, h, d, a, k, w, v, randomize>(batch[i], _skey, {}, _sig);
+    }
+
+    EXPECT_TRUE(std::equal(sig_.begin(), sig_.end(), _sig.begin()));
+    EXPECT_TRUE((sphincs_plus::verify<n, h, d, a, k, w, v>(batch[i], _sig, _pkey)));
+  }
+}
+
+TEST(SphincsPlus, MultiSignByteIdentical)
+{
+  test_multi_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple, false>(1, 32);
+  test_multi_sign<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::robust, true>(3, 32);
+  test_multi_sign<16, 63, 7, 12, 14, 16, sphincs_plus_hashing::variant::simple, false>(2, 32);
+  test_multi_sign<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple, false>(5, 16);
+  test_multi_sign<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::robust, true>(4, 64);
+}
@@ -0,0 +1,92 @@
+#include "prehash.hpp"
+#include "prng.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test that ParallelHash based message pre-hashing produces same digest, irrespective of how many threads are used for
+// compressing message blocks, while digest changes when block length changes.
+static inline void
+test_parallel_hash(const size_t mlen, const size_t block_len)
+{
+  constexpr size_t dlen = 64;
+
+  std::vector<uint8_t> msg(mlen, 0);
+  auto _msg = std::span(msg);
+
+  prng::prng_t prng;
+  prng.read(_msg);
+
+  std::array<uint8_t, dlen> dig0{};
+  sphincs_plus_prehash::parallel_hash<dlen>(_msg, dig0, block_len, 1);
+
+  for (size_t thread_cnt : { 2ul, 3ul, 4ul, 7ul, 16ul }) {
+    std::array<uint8_t, dlen> dig1{};
+    sphincs_plus_prehash::parallel_hash<dlen>(_msg, dig1, block_len, thread_cnt);
+
+    EXPECT_EQ(dig0, dig1);
+  }
+
+  std::array<uint8_t, dlen> dig2{};
+  sphincs_plus_prehash::parallel_hash<dlen>(_msg, dig2, block_len * 2, 4);
+
+  EXPECT_NE(dig0, dig2);
+}
+
+TEST(SphincsPlus, ParallelHashThreadCountIndependence)
+{
+  test_parallel_hash(0, 1024);
+  test_parallel_hash(1, 1024);
+  test_parallel_hash(1023, 1024);
+  test_parallel_hash(1024, 1024);
+  test_parallel_hash(1025, 1024);
+  test_parallel_hash(1ul << 20, 4096);
+  test_parallel_hash((1ul << 20) + 17, 8192);
+}
+
+// Test correctness of SPHINCS+ signing/ verification, when large message is pre-hashed using ParallelHash.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_prehash_sign_verify(const size_t mlen, const size_t block_len)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus_prehash::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig, block_len, 4);
+
+  EXPECT_TRUE((sphincs_plus_prehash::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, block_len, 1)));
+  EXPECT_TRUE((sphincs_plus_prehash::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, block_len, 3)));
+  EXPECT_FALSE((sphincs_plus_prehash::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, block_len * 2, 4)));
+
+  _msg[mlen / 2] ^= 0x01;
+  EXPECT_FALSE((sphincs_plus_prehash::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, block_len, 4)));
+}
+
+TEST(SphincsPlus, ParallelHashPreHashedSignVerify)
+{
+  test_prehash_sign_verify<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(1ul << 20, 8192);
+  test_prehash_sign_verify<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::robust>(1ul << 18, 4096);
+}
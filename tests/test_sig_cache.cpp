@@ -0,0 +1,120 @@
+#include "prng.hpp"
+#include "sig_cache.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// Test correctness of SPHINCS+ verification, when verified-signature result cache is used, ensuring that
+//
+// - Repeated verification of a valid signature hits cache
+// - Invalid signatures are never remembered, so they keep getting rejected
+// - Cached result is bound to message, public key and parameter set
+// - Cache is safe to be shared among threads
+//
+// with random data.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_sig_cache(const size_t mlen)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> msg(mlen, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _msg = std::span(msg);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_msg);
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus::sign<n, h, d, a, k, w, v>(_msg, _skey, {}, _sig);
+
+  sphincs_plus_sig_cache::cache_t cache(1024, 4);
+  EXPECT_EQ(cache.get_capacity(), 1024ul);
+
+  // Invalid signature must be rejected each time, without ever being remembered
+  _sig[siglen - 1] ^= 0x01;
+  EXPECT_FALSE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+  EXPECT_FALSE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+  _sig[siglen - 1] ^= 0x01;
+
+  EXPECT_EQ(cache.get_insertions(), 0ul);
+  EXPECT_EQ(cache.get_misses(), 2ul);
+
+  EXPECT_TRUE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+  EXPECT_EQ(cache.get_insertions(), 1ul);
+
+  // Repeated verification, from many threads, must hit cache
+  constexpr size_t thread_cnt = 4;
+  constexpr size_t rounds = 64;
+
+  std::vector<std::thread> workers;
+  std::atomic<bool> flg = true;
+
+  for (size_t i = 0; i < thread_cnt; i++) {
+    workers.emplace_back([&]() {
+      for (size_t j = 0; j < rounds; j++) {
+        if (!sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)) {
+          flg = false;
+        }
+      }
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(cache.get_hits(), thread_cnt * rounds);
+  EXPECT_EQ(cache.get_misses(), 3ul);
+  EXPECT_EQ(cache.get_insertions(), 1ul);
+
+  // Cached result must not be reused for some other message or public key
+  if (mlen > 0) {
+    _msg[0] ^= 0x01;
+    EXPECT_FALSE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+    _msg[0] ^= 0x01;
+  }
+
+  _pkey[pklen - 1] ^= 0x01;
+  EXPECT_FALSE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+  _pkey[pklen - 1] ^= 0x01;
+
+  // Nor for the other variant of same parameter set, which has same key and signature lengths
+  constexpr auto u = v == sphincs_plus_hashing::variant::robust ? sphincs_plus_hashing::variant::simple : sphincs_plus_hashing::variant::robust;
+
+  const uint64_t misses = cache.get_misses();
+  EXPECT_FALSE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, u>(_msg, _sig, _pkey, cache)));
+  EXPECT_EQ(cache.get_misses(), misses + 1);
+  EXPECT_EQ(cache.get_insertions(), 1ul);
+
+  // Once forgotten, signature needs to be verified again
+  cache.clear();
+  EXPECT_TRUE((sphincs_plus_sig_cache::verify<n, h, d, a, k, w, v>(_msg, _sig, _pkey, cache)));
+  EXPECT_EQ(cache.get_insertions(), 2ul);
+}
+
+TEST(SphincsPlus, SignatureResultCache)
+{
+  test_sig_cache<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(0);
+  test_sig_cache<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::robust>(32);
+  test_sig_cache<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>(64);
+  test_sig_cache<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::simple>(1024);
+}
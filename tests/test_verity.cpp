@@ -0,0 +1,122 @@
+#include "prng.hpp"
+#include "verity.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test correctness of SPHINCS+ chunk-level signed content, using
+//
+// - Keypair generation
+// - Building Merkle Tree over chunks of an object, on different # -of threads
+// - Signing object header
+// - Verifying each chunk, using its inclusion proof, with and without authenticated header cache
+//
+// with random data.
+template<size_t n, uint32_t h, uint32_t d, uint32_t a, uint32_t k, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_verity(const size_t object_len, const size_t chunk_len)
+{
+  constexpr size_t pklen = sphincs_plus_utils::get_sphincs_pkey_len<n>();
+  constexpr size_t sklen = sphincs_plus_utils::get_sphincs_skey_len<n>();
+  constexpr size_t siglen = sphincs_plus_utils::get_sphincs_sig_len<n, h, d, a, k, w>();
+  constexpr size_t hdrlen = sphincs_plus_verity::get_header_len<n>();
+
+  std::vector<uint8_t> sk_seed(n, 0);
+  std::vector<uint8_t> sk_prf(n, 0);
+  std::vector<uint8_t> pk_seed(n, 0);
+  std::vector<uint8_t> pkey(pklen, 0);
+  std::vector<uint8_t> skey(sklen, 0);
+  std::vector<uint8_t> object(object_len, 0);
+  std::vector<uint8_t> sig(siglen, 0);
+
+  auto _sk_seed = std::span<uint8_t, n>(sk_seed);
+  auto _sk_prf = std::span<uint8_t, n>(sk_prf);
+  auto _pk_seed = std::span<uint8_t, n>(pk_seed);
+  auto _pkey = std::span<uint8_t, pklen>(pkey);
+  auto _skey = std::span<uint8_t, sklen>(skey);
+  auto _object = std::span(object);
+  auto _sig = std::span<uint8_t, siglen>(sig);
+
+  prng::prng_t prng;
+  prng.read(_sk_seed);
+  prng.read(_sk_prf);
+  prng.read(_pk_seed);
+  prng.read(_object);
+
+  // Object header must not depend on # -of threads used for building Merkle Tree
+  sphincs_plus_verity::tree_t<n> tree(_object, chunk_len, 1);
+
+  std::array<uint8_t, hdrlen> header{};
+  tree.get_header(header);
+
+  for (size_t thread_cnt : { 2ul, 3ul, 4ul, 8ul }) {
+    sphincs_plus_verity::tree_t<n> tree_(_object, chunk_len, thread_cnt);
+
+    std::array<uint8_t, hdrlen> header_{};
+    tree_.get_header(header_);
+
+    EXPECT_EQ(header, header_);
+  }
+
+  sphincs_plus::keygen<n, h, d, w, v>(_sk_seed, _sk_prf, _pk_seed, _skey, _pkey);
+  sphincs_plus_verity::sign<n, h, d, a, k, w, v>(header, _skey, {}, _sig);
+
+  const size_t chunk_cnt = tree.get_chunk_cnt();
+  const size_t proof_len = tree.get_proof_len();
+
+  EXPECT_EQ(chunk_cnt, sphincs_plus_verity::get_chunk_cnt(object_len, chunk_len));
+  EXPECT_EQ(proof_len, sphincs_plus_verity::get_proof_len<n>(object_len, chunk_len));
+
+  std::vector<uint8_t> proof(proof_len, 0);
+  auto _proof = std::span(proof);
+
+  sphincs_plus_verity::verifier_t<n, h, d, a, k, w, v> verifier(_pkey);
+
+  for (size_t i = 0; i < chunk_cnt; i++) {
+    const size_t off = i * chunk_len;
+    auto chunk = _object.subspan(off, std::min(chunk_len, object_len - off));
+
+    tree.get_proof(i, _proof);
+
+    EXPECT_TRUE(verifier.verify_chunk(header, _sig, i, chunk, _proof));
+  }
+
+  // Only the first chunk of the object requires verifying SPHINCS+ signature
+  EXPECT_EQ(verifier.get_misses(), 1ul);
+  EXPECT_EQ(verifier.get_hits(), chunk_cnt - 1);
+
+  auto chunk = _object.subspan(0, std::min(chunk_len, object_len));
+  tree.get_proof(0, _proof);
+
+  EXPECT_TRUE((sphincs_plus_verity::verify_chunk<n, h, d, a, k, w, v>(header, _sig, 0, chunk, _proof, _pkey)));
+
+  // Chunk must not be verified at some other index
+  if (chunk_cnt > 1) {
+    EXPECT_FALSE(verifier.verify_chunk(header, _sig, 1, chunk, _proof));
+  }
+
+  // Tampered or truncated chunk must not be verified, neither with nor without authenticated header cache
+  if (object_len > 0) {
+    std::vector<uint8_t> tampered(chunk.begin(), chunk.end());
+    tampered[tampered.size() / 2] ^= 0x01;
+
+    EXPECT_FALSE((sphincs_plus_verity::verify_chunk<n, h, d, a, k, w, v>(header, _sig, 0, tampered, _proof, _pkey)));
+    EXPECT_FALSE(verifier.verify_chunk(header, _sig, 0, tampered, _proof));
+    EXPECT_FALSE(verifier.verify_chunk(header, _sig, 0, chunk.first(chunk.size() - 1), _proof));
+  }
+
+  // Header claiming some other object length must not be verified
+  auto header_ = header;
+  header_[12] ^= 0x01;
+
+  EXPECT_FALSE((sphincs_plus_verity::verify_chunk<n, h, d, a, k, w, v>(header_, _sig, 0, chunk, _proof, _pkey)));
+}
+
+TEST(SphincsPlus, VeritySignVerify)
+{
+  test_verity<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(0, 4096);
+  test_verity<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(1, 4096);
+  test_verity<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::simple>(4096, 4096);
+  test_verity<16, 66, 22, 6, 33, 16, sphincs_plus_hashing::variant::robust>(4096 * 5 + 7, 4096);
+  test_verity<24, 66, 22, 8, 33, 16, sphincs_plus_hashing::variant::simple>(1ul << 20, 1ul << 12);
+  test_verity<32, 68, 17, 9, 35, 16, sphincs_plus_hashing::variant::robust>((1ul << 20) + 1, 1ul << 16);
+}
@@ -22,6 +22,7 @@ test_wots_plus()
   std::vector<uint8_t> sk_seed(n, 0);
   std::vector<uint8_t> pk_seed(n, 0);
   sphincs_plus_adrs::wots_hash_t adrs{};
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> adrs_bytes{};
   std::vector<uint8_t> msg(n, 0);
 
   auto _sk_seed = std::span<uint8_t, n>(sk_seed);
@@ -40,7 +41,8 @@ test_wots_plus()
   prng::prng_t prng;
   prng.read(_sk_seed);
   prng.read(_pk_seed);
-  prng.read(adrs.data);
+  prng.read(adrs_bytes);
+  adrs = sphincs_plus_adrs::adrs_t(adrs_bytes);
   prng.read(_msg);
 
   sphincs_plus_wots::pkgen<n, w, v>(_sk_seed, _pk_seed, adrs, _pkey0);
@@ -67,3 +69,76 @@ TEST(SphincsPlus, WOTS_PlusNISTSecurityLevel5)
   test_wots_plus<32, 16, sphincs_plus_hashing::variant::robust>();
   test_wots_plus<32, 16, sphincs_plus_hashing::variant::simple>();
 }
+
+// Test that WOTS+ public key, recovered by walking uneven chains together in lanes, is same as the one recovered by
+// walking each chain on its own, following algorithm 6 of SPHINCS+ specification, and that lane occupancy accounts for
+// every F call.
+template<size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_wots_chain_lanes()
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t lanes = sphincs_plus_hashing::F_LANES;
+
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> msg{};
+  std::array<uint8_t, n * len> sig{};
+  sphincs_plus_adrs::wots_hash_t adrs{};
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> adrs_bytes{};
+
+  auto _sig = std::span(sig);
+
+  prng::prng_t prng;
+  prng.read(pk_seed);
+  prng.read(adrs_bytes);
+  adrs = sphincs_plus_adrs::adrs_t(adrs_bytes);
+
+  for (size_t t = 0; t < 16; t++) {
+    prng.read(msg);
+    prng.read(_sig);
+
+    std::array<uint8_t, len> digits{};
+    sphincs_plus_wots::compute_digits<n, w>(msg, digits);
+
+    std::array<uint8_t, n * len> limbs{};
+    auto _limbs = std::span(limbs);
+
+    uint64_t steps = 0;
+    uint32_t max_steps = 0;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(len); i++) {
+      const uint32_t sidx = static_cast<uint32_t>(digits[i]);
+      const uint32_t cnt = static_cast<uint32_t>(w - 1) - sidx;
+
+      adrs.set_chain_address(i);
+      sphincs_plus_wots::chain<n, w, v>(std::span<const uint8_t, n>(_sig.subspan(i * n, n)), sidx, cnt, adrs, pk_seed, std::span<uint8_t, n>(_limbs.subspan(i * n, n)));
+
+      steps += cnt;
+      max_steps = std::max(max_steps, cnt);
+    }
+
+    sphincs_plus_adrs::wots_pk_t pk_adrs{ adrs };
+    pk_adrs.set_type(sphincs_plus_adrs::type_t::WOTS_PK);
+    pk_adrs.set_keypair_address(adrs.get_keypair_address());
+
+    std::array<uint8_t, n> pkey0{};
+    std::array<uint8_t, n> pkey1{};
+    sphincs_plus_hashing::t_l<n, len, v>(pk_seed, pk_adrs, limbs, pkey0);
+
+    sphincs_plus_wots::lane_stats_t stats{};
+    sphincs_plus_wots::pk_from_sig<n, w, v>(sig, msg, pk_seed, adrs, pkey1, &stats);
+
+    EXPECT_EQ(pkey0, pkey1);
+    EXPECT_EQ(stats.busy, steps);
+    EXPECT_GE(stats.rounds, static_cast<uint64_t>(max_steps));
+    EXPECT_GE(stats.rounds * lanes, steps);
+    EXPECT_LE(stats.get_occupancy(), 1.);
+  }
+}
+
+TEST(SphincsPlus, WOTS_PlusChainLanes)
+{
+  test_wots_chain_lanes<16, 16, sphincs_plus_hashing::variant::robust>();
+  test_wots_chain_lanes<24, 16, sphincs_plus_hashing::variant::simple>();
+  test_wots_chain_lanes<32, 16, sphincs_plus_hashing::variant::simple>();
+}
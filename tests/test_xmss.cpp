@@ -1,5 +1,6 @@
 #include "prng.hpp"
 #include "xmss.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <vector>
@@ -24,6 +25,7 @@ test_xmss()
   std::vector<uint8_t> sk_seed(n, 0);
   std::vector<uint8_t> pk_seed(n, 0);
   sphincs_plus_adrs::adrs_t adrs{};
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> adrs_bytes{};
   std::vector<uint8_t> msg(n, 0);
 
   auto _sk_seed = std::span<uint8_t, n>(sk_seed);
@@ -42,7 +44,8 @@ test_xmss()
   prng::prng_t prng;
   prng.read(_sk_seed);
   prng.read(_pk_seed);
-  prng.read(adrs.data);
+  prng.read(adrs_bytes);
+  adrs = sphincs_plus_adrs::adrs_t(adrs_bytes);
   prng.read(_msg);
 
   sphincs_plus_xmss::pkgen<h, n, w, v>(_sk_seed, _pk_seed, adrs, _pkey0);
@@ -75,3 +78,60 @@ TEST(SphincsPlus, XMSSNISTSecurityLevel5)
   test_xmss<68 / 17, 32, 16, sphincs_plus_hashing::variant::robust>();
   test_xmss<68 / 17, 32, 16, sphincs_plus_hashing::variant::simple>();
 }
+
+// Test that single-pass XMSS signing, fusing WOTS+ signing with computation of the signing leaf, while building the
+// tree level by level, produces byte-identical XMSS signature and root, as computed by algorithm 9 and 10 of SPHINCS+
+// specification. Every leaf index is tried for shallow trees, while for trees taller than `LEVEL_HEIGHT`, which get
+// split into subtrees, leaves at both ends of each subtree are tried.
+template<uint32_t h, size_t n, size_t w, sphincs_plus_hashing::variant v>
+static inline void
+test_xmss_sign_and_root()
+{
+  constexpr size_t len = sphincs_plus_utils::compute_wots_len<n, w>();
+  constexpr size_t sig_len = len * n + h * n;
+  constexpr uint32_t s_leaf_cnt = 1u << std::min(h, sphincs_plus_xmss::LEVEL_HEIGHT);
+
+  std::array<uint8_t, n> sk_seed{};
+  std::array<uint8_t, n> pk_seed{};
+  std::array<uint8_t, n> msg{};
+  sphincs_plus_adrs::adrs_t adrs{};
+  std::array<uint8_t, sphincs_plus_adrs::ADRS_BYTE_WIDTH> adrs_bytes{};
+
+  prng::prng_t prng;
+  prng.read(sk_seed);
+  prng.read(pk_seed);
+  prng.read(adrs_bytes);
+  adrs = sphincs_plus_adrs::adrs_t(adrs_bytes);
+  prng.read(msg);
+
+  std::vector<uint32_t> idxs;
+  for (uint32_t idx = 0; idx < (1u << h); idx++) {
+    if ((h <= sphincs_plus_xmss::LEVEL_HEIGHT) || ((idx % s_leaf_cnt) == 0) || ((idx % s_leaf_cnt) == (s_leaf_cnt - 1))) {
+      idxs.push_back(idx);
+    }
+  }
+
+  for (const uint32_t idx : idxs) {
+    std::array<uint8_t, sig_len> sig0{};
+    std::array<uint8_t, sig_len> sig1{};
+    std::array<uint8_t, n> root0{};
+    std::array<uint8_t, n> root1{};
+
+    sphincs_plus_xmss::sign<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, sig0);
+    sphincs_plus_xmss::pk_from_sig<h, n, w, v>(idx, sig0, msg, pk_seed, adrs, root0);
+    sphincs_plus_xmss::sign_and_root<h, n, w, v>(msg, sk_seed, idx, pk_seed, adrs, sig1, root1);
+
+    EXPECT_EQ(sig0, sig1);
+    EXPECT_EQ(root0, root1);
+  }
+}
+
+TEST(SphincsPlus, XMSSSinglePassSignAndRoot)
+{
+  test_xmss_sign_and_root<66 / 22, 16, 16, sphincs_plus_hashing::variant::robust>();
+  test_xmss_sign_and_root<66 / 22, 24, 16, sphincs_plus_hashing::variant::simple>();
+  test_xmss_sign_and_root<68 / 17, 32, 16, sphincs_plus_hashing::variant::simple>();
+  test_xmss_sign_and_root<64 / 8, 32, 16, sphincs_plus_hashing::variant::robust>();
+  test_xmss_sign_and_root<63 / 7, 16, 16, sphincs_plus_hashing::variant::simple>();
+  test_xmss_sign_and_root<4, 16, 256, sphincs_plus_hashing::variant::simple>();
+}